@@ -0,0 +1,160 @@
+//
+//  AllocationCounter.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+// The replacement operators are linked into the whole test binary. They only count while an
+// AllocationCounter is alive, and otherwise behave like the default ones (malloc, retried
+// through the new handler), so the other tests don't see a different allocator. Every form
+// (array, aligned, nothrow) is replaced so that memory from any operator new is released by the
+// matching delete.
+
+namespace {
+thread_local bool countAllocations = false;
+thread_local std::uint64_t allocations = 0;
+
+void* allocate(std::size_t size, std::size_t alignment) {
+    if (countAllocations) {
+        allocations++;
+    }
+    size = size ? size : 1;
+    while (true) {
+        void* ptr = nullptr;
+        if (alignment <= alignof(std::max_align_t)) {
+            ptr = std::malloc(size);
+        } else {
+#if defined(_MSC_VER)
+            ptr = _aligned_malloc(size, alignment);
+#else
+            if (posix_memalign(&ptr, alignment, size) != 0) {
+                ptr = nullptr;
+            }
+#endif
+        }
+        if (ptr) {
+            return ptr;
+        }
+        auto handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+}
+
+void* operator new(std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, std::max(static_cast<std::size_t>(alignment), sizeof(void*)));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return ::operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    ::operator delete(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    ::operator delete(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    ::operator delete(ptr, alignment);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    ::operator delete(ptr, alignment);
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    ::operator delete(ptr, alignment);
+}
+
+namespace sh {
+AllocationCounter::AllocationCounter() noexcept
+    : start_(allocations), wasCounting_(std::exchange(countAllocations, true)) {}
+
+AllocationCounter::~AllocationCounter() {
+    countAllocations = wasCounting_;
+}
+
+std::uint64_t AllocationCounter::count() const noexcept {
+    return allocations - start_;
+}
+}
@@ -0,0 +1,36 @@
+//
+//  AllocationCounter.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+// Counts the global operator new calls made by the calling thread while it is alive, for tests
+// and benchmarks which check that an operation doesn't allocate. Counters may be nested. Relies
+// on the replacement operators in AllocationCounter.cpp, which has to be linked in.
+// Example :
+// AllocationCounter allocations;
+// signal.emit();
+// REQUIRE(allocations.count() == 0);
+class AllocationCounter : NonCopyable, NonMovable {
+public:
+    AllocationCounter() noexcept;
+    ~AllocationCounter();
+
+    // Allocations made by the calling thread since construction
+    std::uint64_t count() const noexcept;
+
+private:
+    std::uint64_t start_;
+    bool wasCounting_;
+};
+}
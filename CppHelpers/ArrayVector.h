@@ -8,11 +8,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <exception>
+#include <stdexcept>
 #include <type_traits>
 
+#include "Relocatable.h"
+
 namespace sh {
 namespace detail {
 #define ARRAY_VECTOR_STORAGE_INTERNALS \
@@ -83,7 +88,13 @@ public:
     // The delegating constructor guarantees that detructor is called,
     // so there are no leaks.
     constexpr ArrayVector(ArrayVector&& other) noexcept(NTMC) : ArrayVector() {
-        if constexpr (std::is_trivially_move_constructible_v<T>) {
+        if constexpr (IsTriviallyRelocatable_v<T>) {
+            // The elements now live in *this, so other must not destroy them
+            std::memcpy(this->storage_.data(), other.storage_.data(), sizeof(T) * other.size_);
+            this->size_ = other.size_;
+            other.size_ = 0;
+            return;
+        } else if constexpr (std::is_trivially_move_constructible_v<T>) {
             auto ptr = reinterpret_cast<T*>(this->storage_.data());
             auto ptrOther = reinterpret_cast<const T*>(other.storage_.data());
             
@@ -0,0 +1,313 @@
+//
+//  AsyncGuard.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "AsyncGuard.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+// Minimal lazily started task which runs its cleanups before resuming whoever awaits it
+class Task {
+public:
+    struct promise_type : sh::AsyncCleanupPromise {
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                handle.promise().finished = true;
+                return handle.promise().runCleanups(handle.promise().continuation);
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+        bool finished = false;
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    void start() {
+        handle_.resume();
+    }
+
+    bool finished() const {
+        return handle_.promise().finished;
+    }
+
+    bool failed() const {
+        return handle_.promise().exception != nullptr;
+    }
+
+    void cancel() {
+        std::exchange(handle_, nullptr).destroy();
+    }
+
+    bool await_ready() noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+        handle_.promise().continuation = continuation;
+        return handle_;
+    }
+
+    void await_resume() {
+        if (handle_.promise().exception) {
+            std::rethrow_exception(handle_.promise().exception);
+        }
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Stands in for asynchronous I/O, suspends until the test resumes it
+struct Event {
+    bool await_ready() noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept {
+        waiter = handle;
+    }
+
+    void await_resume() noexcept {}
+
+    void fire() {
+        std::exchange(waiter, nullptr).resume();
+    }
+
+    std::coroutine_handle<> waiter;
+};
+
+using Log = std::vector<std::string>;
+
+sh::AsyncCleanup cleanup(Log& log, std::string name) {
+    log.push_back(name);
+    co_return;
+}
+
+// Logs its destruction, to pin down when cleanups run relative to the coroutine's locals
+struct Local {
+    Log& log;
+    ~Local() {
+        log.push_back("local destroyed");
+    }
+};
+
+sh::AsyncCleanup asyncCleanup(Log& log, Event& event, std::string name) {
+    log.push_back(name + " started");
+    co_await event;
+    log.push_back(name + " done");
+}
+
+// Only reads name after suspending, so that it has to outlive the suspension
+sh::AsyncCleanup closeAsync(Log& log, Event& event, const std::string& name) {
+    co_await event;
+    log.push_back(name + " closed");
+}
+
+struct Cancelled : std::runtime_error {
+    Cancelled() : std::runtime_error("cancelled") {}
+};
+}
+
+TEST_CASE("[AsyncScopeGuard] Cleanup runs when the task finishes") {
+    Log log;
+
+    SECTION("in reverse order of registration") {
+        auto task = [](Log& log) -> Task {
+            co_await sh::deferAsync(cleanup(log, "first"));
+            co_await sh::deferAsync(cleanup(log, "second"));
+            log.push_back("body");
+        }(log);
+        REQUIRE(log.empty());
+        task.start();
+        REQUIRE(task.finished());
+        REQUIRE(log == Log{"body", "second", "first"});
+    }
+
+    SECTION("on exceptions") {
+        auto task = [](Log& log) -> Task {
+            co_await sh::deferAsync(cleanup(log, "cleanup"));
+            throw std::runtime_error("failed");
+        }(log);
+        task.start();
+        REQUIRE(task.failed());
+        REQUIRE(log == Log{"cleanup"});
+    }
+
+    SECTION("unless dismissed") {
+        auto task = [](Log& log) -> Task {
+            co_await sh::deferAsync(cleanup(log, "kept"));
+            auto guard = co_await sh::deferAsync(cleanup(log, "dismissed"));
+            guard.dismiss();
+        }(log);
+        task.start();
+        REQUIRE(log == Log{"kept"});
+    }
+}
+
+// Cleanups must not refer to locals of the body, see deferAsync
+TEST_CASE("[AsyncScopeGuard] Cleanup runs after locals are destroyed") {
+    Log log;
+
+    SECTION("when the task finishes") {
+        auto task = [](Log& log) -> Task {
+            Local local{log};
+            co_await sh::deferAsync(cleanup(log, "cleanup"));
+        }(log);
+        task.start();
+        REQUIRE(log == Log{"local destroyed", "cleanup"});
+    }
+}
+
+TEST_CASE("[AsyncScopeGuard] Awaiters resume after asynchronous cleanup") {
+    Log log;
+    Event event;
+
+    auto inner = [](Log& log, Event& event) -> Task {
+        co_await sh::deferAsync(asyncCleanup(log, event, "close"));
+        log.push_back("inner");
+    };
+    auto outer = [](Log& log, Task inner) -> Task {
+        co_await inner;
+        log.push_back("outer");
+    }(log, inner(log, event));
+
+    outer.start();
+    REQUIRE(log == Log{"inner", "close started"});
+    REQUIRE_FALSE(outer.finished());
+
+    event.fire();
+    REQUIRE(log == Log{"inner", "close started", "close done", "outer"});
+    REQUIRE(outer.finished());
+}
+
+TEST_CASE("[AsyncScopeGuard] Cleanups can refer to parameters") {
+    Log log;
+    Event suspended;
+    Event closing;
+    bool cancelled = false;
+
+    // Long enough not to fit in the small string buffer, so that a dangling read is visible to ASAN
+    auto task = [](Log& log, Event& suspended, Event& closing, bool& cancelled,
+                   std::string name) -> Task {
+        co_await sh::deferAsync(closeAsync(log, closing, name));
+        co_await suspended;
+        if (cancelled) {
+            throw Cancelled();
+        }
+        log.push_back("unreachable");
+    }(log, suspended, closing, cancelled, std::string(64, 'c'));
+
+    // Cancelling through the body awaits the cleanup while the frame is still alive
+    task.start();
+    cancelled = true;
+    suspended.fire();
+    REQUIRE(log.empty());
+    REQUIRE(closing.waiter);
+
+    closing.fire();
+    REQUIRE(task.failed());
+    REQUIRE(log == Log{std::string(64, 'c') + " closed"});
+}
+
+TEST_CASE("[AsyncScopeGuard] Cleanups run when a suspended task is destroyed") {
+    Log log;
+    Event suspended;
+
+    SECTION("in reverse order of registration") {
+        auto task = [](Log& log, Event& suspended) -> Task {
+            co_await sh::deferAsync(cleanup(log, "first"));
+            auto guard = co_await sh::deferAsync(cleanup(log, "dismissed"));
+            guard.dismiss();
+            co_await sh::deferAsync(cleanup(log, "second"));
+            co_await suspended;
+            log.push_back("unreachable");
+        }(log, suspended);
+        task.start();
+        REQUIRE(log.empty());
+        task.cancel();
+        REQUIRE(log == Log{"second", "first"});
+    }
+
+    SECTION("detached, when the cleanup suspends") {
+        Event closing;
+        auto task = [](Log& log, Event& suspended, Event& closing) -> Task {
+            Local local{log};
+            co_await sh::deferAsync(asyncCleanup(log, closing, "close"));
+            co_await suspended;
+            log.push_back("unreachable");
+        }(log, suspended, closing);
+        task.start();
+        task.cancel();
+        REQUIRE(log == Log{"local destroyed", "close started"});
+
+        // The cleanup owns its frame and finishes after the task is gone
+        closing.fire();
+        REQUIRE(log == Log{"local destroyed", "close started", "close done"});
+    }
+}
+
+TEST_CASE("[AsyncScopeGuard] Suspended tasks without pending cleanups can be destroyed") {
+    Log log;
+    Event suspended;
+    Event closing;
+
+    auto task = [](Log& log, Event& suspended, Event& closing, std::string name) -> Task {
+        auto guard = co_await sh::deferAsync(closeAsync(log, closing, name));
+        guard.dismiss();
+        co_await suspended;
+        log.push_back("unreachable");
+    }(log, suspended, closing, std::string(64, 'c'));
+
+    // The dismissed cleanup is freed along with the frame and never runs
+    task.start();
+    task.cancel();
+    REQUIRE(log.empty());
+    REQUIRE_FALSE(closing.waiter);
+}
+
+#endif
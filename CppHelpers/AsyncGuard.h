@@ -0,0 +1,231 @@
+//
+//  AsyncGuard.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+// Coroutine support needs C++20, in C++17 builds this header is empty.
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "NonCopyable.h"
+
+namespace sh {
+// Lazily started coroutine which performs asynchronous cleanup (eg. flushing and closing a
+// connection). It only starts running once the enclosing coroutine finishes, see deferAsync.
+// Cleanup cannot fail, an exception escaping the cleanup coroutine terminates.
+// Example :
+// AsyncCleanup closeAsync(Connection& conn) {
+//     co_await conn.flush();
+//     co_await conn.close();
+// }
+class AsyncCleanup : NonCopyable {
+public:
+    struct promise_type {
+        AsyncCleanup get_return_object() noexcept {
+            return AsyncCleanup(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        // Cleanups destroy themselves once they are done and hand over to the next one in the
+        // chain, or to whoever is waiting for the whole chain (if anyone).
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                auto next = handle.promise().next;
+                handle.destroy();
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+
+        std::coroutine_handle<> next;
+        // Intrusive list of the cleanups registered with the same coroutine
+        std::coroutine_handle<promise_type> previous;
+        bool dismissed = false;
+    };
+
+    AsyncCleanup(AsyncCleanup&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    // A cleanup which was never registered is destroyed without running
+    ~AsyncCleanup() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+private:
+    friend class AsyncCleanupPromise;
+    friend class DeferAsync;
+
+    explicit AsyncCleanup(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Mixin for promise types of coroutines which want to use AsyncScopeGuard. Registered cleanups
+// are linked through their own coroutine frames, so guards don't allocate anything beyond the
+// frames themselves.
+// The derived promise decides when cleanups run by calling runCleanups() from its final
+// awaiter, which covers both normal completion and exceptions. Example :
+// struct promise_type : sh::AsyncCleanupPromise {
+//     struct FinalAwaiter {
+//         bool await_ready() noexcept { return false; }
+//         std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+//             return h.promise().runCleanups(h.promise().continuation);
+//         }
+//         void await_resume() noexcept {}
+//     };
+//     FinalAwaiter final_suspend() noexcept { return {}; }
+//     ...
+// };
+// If the coroutine is destroyed while suspended (ie. cancelled), the cleanups which are still
+// pending are started from the promise's destructor instead. Nothing can wait for them there, so
+// they run detached : each cleanup frame frees itself once done, and the first suspension of a
+// cleanup may outlive the coroutine's frame. Cleanups which can be cancelled must therefore hold
+// on to what they need by value (their own parameters) rather than refer to the coroutine's.
+class AsyncCleanupPromise : NonCopyable {
+public:
+    AsyncCleanupPromise() = default;
+
+    ~AsyncCleanupPromise() {
+        runCleanups(nullptr).resume();
+    }
+
+    // Chains the registered cleanups in reverse order of registration, followed by then.
+    // Returns the handle to transfer to, which is then itself (or a no-op coroutine if then is null)
+    // if nothing is registered.
+    std::coroutine_handle<> runCleanups(std::coroutine_handle<> then) noexcept {
+        std::coroutine_handle<> first = then ? then : std::noop_coroutine();
+        Handle last;
+        while (auto cleanup = pop()) {
+            if (last) {
+                last.promise().next = cleanup;
+            } else {
+                first = cleanup;
+            }
+            last = cleanup;
+        }
+        if (last) {
+            last.promise().next = then;
+        }
+        return first;
+    }
+
+private:
+    friend class DeferAsync;
+    using Handle = std::coroutine_handle<AsyncCleanup::promise_type>;
+
+    void push(Handle cleanup) noexcept {
+        cleanup.promise().previous = cleanups_;
+        cleanups_ = cleanup;
+    }
+
+    // Returns the most recently registered cleanup which wasn't dismissed
+    Handle pop() noexcept {
+        while (cleanups_) {
+            auto cleanup = cleanups_;
+            cleanups_ = cleanup.promise().previous;
+            if (!cleanup.promise().dismissed) {
+                return cleanup;
+            }
+            cleanup.destroy();
+        }
+        return nullptr;
+    }
+
+    Handle cleanups_;
+};
+
+// Handle to a cleanup registered through deferAsync, which can only be used to dismiss it.
+// Unlike StackGuard the guard doesn't run anything itself : the cleanup is owned and run by the
+// enclosing coroutine's AsyncCleanupPromise, so it only runs if the promise type derives from it
+// and calls runCleanups() from its final awaiter (or is destroyed). The guard must not outlive
+// the enclosing coroutine.
+class AsyncScopeGuard {
+public:
+    // The cleanup won't run, its frame is freed along with the enclosing coroutine.
+    void dismiss() noexcept {
+        handle_.promise().dismissed = true;
+    }
+
+private:
+    friend class DeferAsync;
+
+    explicit AsyncScopeGuard(std::coroutine_handle<AsyncCleanup::promise_type> handle) noexcept
+        : handle_(handle) {}
+
+    std::coroutine_handle<AsyncCleanup::promise_type> handle_;
+};
+
+// Awaitable returned by deferAsync
+class DeferAsync : NonCopyable {
+public:
+    explicit DeferAsync(AsyncCleanup cleanup) noexcept
+        : cleanup_(std::move(cleanup)), registered_(cleanup_.handle_) {}
+
+    bool await_ready() noexcept {
+        return false;
+    }
+
+    // Never actually suspends, this is only used to get hold of the enclosing promise
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        static_assert(std::is_base_of_v<AsyncCleanupPromise, Promise>,
+                      "The enclosing coroutine's promise must derive from AsyncCleanupPromise");
+        AsyncCleanupPromise& promise = handle.promise();
+        promise.push(std::exchange(cleanup_.handle_, nullptr));
+        return false;
+    }
+
+    AsyncScopeGuard await_resume() noexcept {
+        return AsyncScopeGuard(registered_);
+    }
+
+private:
+    AsyncCleanup cleanup_;
+    std::coroutine_handle<AsyncCleanup::promise_type> registered_;
+};
+
+// Registers cleanup with the enclosing coroutine, it is awaited once the coroutine finishes
+// (normally or because of an exception). Cleanups run in reverse order of registration.
+// Example :
+// Task<void> handle(Connection conn) {
+//     auto guard = co_await sh::deferAsync(closeAsync(conn));
+//     co_await conn.write(...);
+// }
+// Unlike StackGuard, cleanups run from the final awaiter, after the body's locals have been
+// destroyed : a cleanup referring to a local of the body, eg. closeAsync(localConnection),
+// dangles. Parameters are fine as long as the coroutine finishes, but not if it is cancelled,
+// see AsyncCleanupPromise.
+inline DeferAsync deferAsync(AsyncCleanup cleanup) noexcept {
+    return DeferAsync(std::move(cleanup));
+}
+}
+
+#endif
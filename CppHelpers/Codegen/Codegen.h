@@ -0,0 +1,19 @@
+//
+//  Codegen.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+// Shared by the codegen translation units, see check_codegen.sh.
+// These are only declared so that the optimizer has to assume every call can throw
+// and can't see through the cleanup.
+void mayThrow(int step);
+void release(int step) noexcept;
+
+// Every translation unit instantiates the same function shape this many times, each with a
+// distinct lambda, so that per-target instantiation costs show up in the totals.
+#define CODEGEN_REPEAT(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7)
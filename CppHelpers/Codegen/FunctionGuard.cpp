@@ -0,0 +1,38 @@
+//
+//  FunctionGuard.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+
+#include <functional>
+#include <memory>
+
+// The std::function based guard that Guard is meant to replace
+class FunctionGuard {
+public:
+    explicit FunctionGuard(std::function<void()> target) : target_(std::move(target)) {}
+    ~FunctionGuard() {
+        if (target_) {
+            target_();
+        }
+    }
+
+private:
+    std::function<void()> target_;
+};
+
+struct Holder {
+    std::unique_ptr<FunctionGuard> guard;
+};
+
+#define FUNCTION(N) \
+void function##N(Holder& holder, int arg) { \
+    holder.guard = std::make_unique<FunctionGuard>([arg]() noexcept { release(arg + N); }); \
+    mayThrow(arg); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
@@ -0,0 +1,23 @@
+//
+//  InplaceGuard.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+#include "../Guard.h"
+
+// Same shape as MakeGuard.cpp, but the member guard is stored inline
+struct Holder {
+    sh::InplaceGuard<16> guard;
+};
+
+#define FUNCTION(N) \
+void function##N(Holder& holder, int arg) { \
+    holder.guard.reset([arg]() noexcept { release(arg + N); }); \
+    mayThrow(arg); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
@@ -0,0 +1,23 @@
+//
+//  MakeGuard.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+#include "../Guard.h"
+
+// Guards stored as members, where the target type isn't known
+struct Holder {
+    sh::GuardKey guard;
+};
+
+#define FUNCTION(N) \
+void function##N(Holder& holder, int arg) { \
+    holder.guard = sh::makeGuard([arg]() noexcept { release(arg + N); }); \
+    mayThrow(arg); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
@@ -0,0 +1,19 @@
+//
+//  ScopeSuccess.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+#include "../Guard.h"
+
+// Compared against TryCatchSuccess.cpp
+#define FUNCTION(N) \
+void function##N(int arg) { \
+    sh::ScopeSuccess guard([arg]() noexcept { release(arg + N); }); \
+    mayThrow(arg); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
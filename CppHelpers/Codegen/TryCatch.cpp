@@ -0,0 +1,23 @@
+//
+//  TryCatch.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+
+// Baseline: cleanup written by hand
+#define FUNCTION(N) \
+void function##N(int arg) { \
+    try { \
+        mayThrow(arg); \
+    } catch (...) { \
+        release(arg + N); \
+        throw; \
+    } \
+    release(arg + N); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
@@ -0,0 +1,22 @@
+//
+//  TryCatchFail.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+
+// Baseline for ScopeFail: cleanup only on the exceptional path
+#define FUNCTION(N) \
+void function##N(int arg) { \
+    try { \
+        mayThrow(arg); \
+    } catch (...) { \
+        release(arg + N); \
+        throw; \
+    } \
+}
+
+CODEGEN_REPEAT(FUNCTION)
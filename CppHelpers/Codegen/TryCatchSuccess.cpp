@@ -0,0 +1,18 @@
+//
+//  TryCatchSuccess.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include "Codegen.h"
+
+// Baseline for ScopeSuccess: cleanup only on the normal path, exceptions propagate untouched
+#define FUNCTION(N) \
+void function##N(int arg) { \
+    mayThrow(arg); \
+    release(arg + N); \
+}
+
+CODEGEN_REPEAT(FUNCTION)
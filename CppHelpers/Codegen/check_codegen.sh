@@ -0,0 +1,84 @@
+#!/bin/bash
+#
+#  check_codegen.sh
+#  CppHelpers
+#
+#  Compiles the translation units in this directory and checks the codegen claims made in
+#  Guard.h against hand-written code:
+#   - StackGuard compiles to the same code as try/catch
+#   - type-erased guards (makeGuard, GuardHandle, InplaceGuard) are no bigger than std::function based ones
+#  Both checks allow the measured TU to exceed its baseline by up to TOLERANCE percent.
+#  ScopeFail and ScopeSuccess have to call std::uncaught_exceptions() on entry and exit, so they
+#  can't match the hand-written versions (catch + rethrow, and a plain call on the normal path).
+#  They are held to a looser budget instead, SCOPE_TOLERANCE percent over catch + rethrow, and
+#  ScopeSuccess must not exceed ScopeFail (they do the same work on different paths).
+#  For every TU it reports .text size, unwind table size (.eh_frame + .gcc_except_table) and
+#  the number of emitted symbols, which approximates the number of template instantiations.
+#
+#  Usage: ./check_codegen.sh [compiler flags...]    (defaults to -O2)
+#  Environment: CXX (default c++), TOLERANCE and SCOPE_TOLERANCE in percent (default 10 and 60)
+
+set -e
+cd "$(dirname "$0")"
+
+CXX=${CXX:-c++}
+TOLERANCE=${TOLERANCE:-10}
+SCOPE_TOLERANCE=${SCOPE_TOLERANCE:-60}
+FLAGS=${@:-"-O2"}
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+# Prints "<text> <unwind> <symbols>" for an object file
+measure() {
+    local obj=$1
+    if [ "$(uname)" = "Darwin" ]; then
+        size -m "$obj" | awk '
+            /__text/ { text += $NF }
+            /__eh_frame|__gcc_except_tab|__compact_unwind/ { unwind += $NF }
+            END { printf "%d %d ", text, unwind }'
+    else
+        size -A "$obj" | awk '
+            $1 ~ /^\.text/ { text += $2 }
+            $1 ~ /^\.(eh_frame|gcc_except_table)/ { unwind += $2 }
+            END { printf "%d %d ", text, unwind }'
+    fi
+    nm --defined-only "$obj" | grep -c ' [TtWw] ' || true
+}
+
+printf "%-16s %8s %8s %8s\n" "TU" ".text" "unwind" "symbols"
+declare -A TEXT UNWIND
+for src in TryCatch TryCatchFail TryCatchSuccess StackGuard ScopeFail ScopeSuccess MakeGuard GuardHandle InplaceGuard FunctionGuard; do
+    $CXX -std=c++17 $FLAGS -c "$src.cpp" -o "$OUT/$src.o"
+    read -r text unwind symbols <<< "$(measure "$OUT/$src.o")"
+    TEXT[$src]=$text
+    UNWIND[$src]=$unwind
+    printf "%-16s %8d %8d %8d\n" "$src" "$text" "$unwind" "$symbols"
+done
+
+failed=0
+# Fails if $2 exceeds $3 by more than $4 (default TOLERANCE) percent
+expect_at_most() {
+    local name=$1 actual=$2 baseline=$3 tolerance=${4:-$TOLERANCE}
+    if [ $((actual * 100)) -gt $((baseline * (100 + tolerance))) ]; then
+        echo "FAILED: $name ($actual vs $baseline)"
+        failed=1
+    else
+        echo "ok: $name ($actual vs $baseline)"
+    fi
+}
+
+# Reports $1 relative to $2 without failing
+report() {
+    local name=$1 actual=$2 baseline=$3
+    echo "info: $name ($actual vs $baseline, $((actual * 100 / baseline))%)"
+}
+
+expect_at_most "StackGuard .text <= try/catch +${TOLERANCE}%" "${TEXT[StackGuard]}" "${TEXT[TryCatch]}"
+expect_at_most "StackGuard unwind <= try/catch +${TOLERANCE}%" "${UNWIND[StackGuard]}" "${UNWIND[TryCatch]}"
+expect_at_most "ScopeFail .text <= catch/rethrow +${SCOPE_TOLERANCE}%" "${TEXT[ScopeFail]}" "${TEXT[TryCatchFail]}" "$SCOPE_TOLERANCE"
+expect_at_most "ScopeSuccess .text <= ScopeFail +${TOLERANCE}%" "${TEXT[ScopeSuccess]}" "${TEXT[ScopeFail]}"
+report "ScopeSuccess .text vs plain call" "${TEXT[ScopeSuccess]}" "${TEXT[TryCatchSuccess]}"
+expect_at_most "makeGuard .text <= std::function +${TOLERANCE}%" "${TEXT[MakeGuard]}" "${TEXT[FunctionGuard]}"
+expect_at_most "GuardHandle .text <= std::function +${TOLERANCE}%" "${TEXT[GuardHandle]}" "${TEXT[FunctionGuard]}"
+expect_at_most "InplaceGuard .text <= std::function +${TOLERANCE}%" "${TEXT[InplaceGuard]}" "${TEXT[FunctionGuard]}"
+exit $failed
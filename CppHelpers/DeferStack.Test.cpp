@@ -0,0 +1,111 @@
+//
+//  DeferStack.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "DeferStack.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("[DeferStack] static asserts") {
+    using Stack = sh::DeferStack<128>;
+    static_assert(!std::is_copy_constructible_v<Stack>);
+    static_assert(!std::is_move_constructible_v<Stack>);
+    static_assert(!std::is_polymorphic_v<Stack>);
+    static_assert(sizeof(Stack) <= 128 + alignof(std::max_align_t));
+    
+    auto target = []() noexcept {};
+    static_assert(noexcept(std::declval<Stack&>().defer(std::move(target))));
+    static_assert(!noexcept(std::declval<sh::DeferStack<128, true>&>().defer(std::move(target))));
+}
+
+TEST_CASE("[DeferStack] executes in reverse order") {
+    std::vector<int> order;
+    {
+        sh::DeferStack<256> stack;
+        REQUIRE(stack.empty());
+        stack.defer([&order]() noexcept { order.push_back(1); });
+        std::array<char, 3> small{};
+        stack.defer([&order, small]() noexcept { order.push_back(2); });
+        std::string str = "hello";
+        stack.defer([&order, str = std::move(str)]() noexcept { order.push_back(3); });
+        REQUIRE(!stack.empty());
+        REQUIRE(order.empty());
+    }
+    REQUIRE(order == std::vector<int>{3, 2, 1});
+}
+
+TEST_CASE("[DeferStack] commit") {
+    int val = 0;
+    auto ptr = std::make_shared<int>(10);
+    {
+        sh::DeferStack<128> stack;
+        stack.defer([&val, ptr]() noexcept { val++; });
+        REQUIRE(ptr.use_count() == 2);
+        stack.commit();
+        REQUIRE(stack.empty());
+        REQUIRE(ptr.use_count() == 1);
+    }
+    REQUIRE(val == 0);
+}
+
+TEST_CASE("[DeferStack] partial rollback") {
+    std::vector<int> order;
+    sh::DeferStack<256> stack;
+    stack.defer([&order]() noexcept { order.push_back(1); });
+    auto mark = stack.mark();
+    stack.defer([&order]() noexcept { order.push_back(2); });
+    stack.defer([&order]() noexcept { order.push_back(3); });
+    
+    stack.rollbackTo(mark);
+    REQUIRE(order == std::vector<int>{3, 2});
+    REQUIRE(stack.mark() == mark);
+    
+    // The stack can still be used after a rollback
+    stack.defer([&order]() noexcept { order.push_back(4); });
+    stack.rollbackTo(0);
+    REQUIRE(order == std::vector<int>{3, 2, 4, 1});
+    REQUIRE(stack.empty());
+}
+
+TEST_CASE("[DeferStack] targets can defer during rollback") {
+    std::vector<std::string> order;
+    sh::DeferStack<512> stack;
+    stack.defer([&order]() noexcept { order.push_back("first"); });
+    auto mark = stack.mark();
+    std::string name = "outer";
+    stack.defer([&order, &stack, name = std::move(name)]() noexcept {
+        // The new entry must not be built over this (still running) target
+        stack.defer([&order]() noexcept { order.push_back("inner"); });
+        order.push_back(name);
+    });
+    
+    stack.rollbackTo(mark);
+    REQUIRE(order == std::vector<std::string>{"outer", "inner"});
+    REQUIRE(stack.mark() == mark);
+    
+    stack.rollbackTo(0);
+    REQUIRE(order == std::vector<std::string>{"outer", "inner", "first"});
+    REQUIRE(stack.empty());
+}
+
+TEST_CASE("[DeferStack] bounds check") {
+    int val = 0;
+    auto target = [&val]() noexcept { val++; };
+    // Every entry takes up the target and a footer
+    sh::DeferStack<2 * (sizeof(target) + 2 * sizeof(void*)), true> stack;
+    stack.defer(decltype(target)(target));
+    stack.defer(decltype(target)(target));
+    REQUIRE_THROWS_AS(stack.defer(decltype(target)(target)), std::runtime_error);
+    
+    stack.rollbackTo(0);
+    REQUIRE(val == 2);
+}
@@ -0,0 +1,159 @@
+//
+//  DeferStack.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+// A LIFO list of cleanup targets which replaces a series of guards with a single object.
+// Targets of different types are stored back to back in one inline buffer, each followed by
+// a small footer which holds the trampoline that remembers the target type (see Guard).
+// Example :
+// void init() {
+//     DeferStack<128> cleanup;
+//     auto fd = ::open(...);
+//     cleanup.defer([fd]() noexcept { ::close(fd); });
+//     auto mem = ::mmap(...);
+//     cleanup.defer([mem, len]() noexcept { ::munmap(mem, len); });
+//     registerHandlers();
+//     cleanup.commit(); // Everything succeeded, keep the resources
+// }
+// Targets execute in reverse order of registration when the stack goes out of scope. Like
+// Guard, targets must be noexcept so that every registered target is guaranteed to execute.
+// Running out of space asserts, or throws if PerformBoundsCheck is set (in which case the
+// target passed to defer() is not registered).
+template <std::size_t Bytes, bool PerformBoundsCheck = false>
+class DeferStack : NonCopyable, NonMovable {
+public:
+    // Opaque position in the stack, see mark() and rollbackTo()
+    using Mark = std::uint32_t;
+
+    DeferStack() = default;
+
+    ~DeferStack() {
+        rollbackTo(0);
+    }
+
+    template <typename Target, typename = std::enable_if_t<!std::is_lvalue_reference_v<Target>>>
+    void defer(Target&& t) noexcept(!PerformBoundsCheck &&
+                                    std::is_nothrow_constructible_v<std::decay_t<Target>, Target>) {
+        using D = std::decay_t<Target>;
+        static_assert(noexcept(t()), "Cannot defer a target that can throw");
+        static_assert(alignof(D) <= alignof(std::max_align_t), "Over-aligned targets aren't supported");
+        static_assert(sizeof(D) + sizeof(Footer) <= Bytes, "Target can never fit in the buffer");
+
+        const auto targetOffset = alignUp(used_, alignof(D));
+        const auto footerOffset = alignUp(targetOffset + sizeof(D), alignof(Footer));
+        const auto end = footerOffset + sizeof(Footer);
+        checkSize(end);
+
+        new (&storage_[targetOffset]) D(std::forward<Target>(t));
+        new (&storage_[footerOffset]) Footer{
+            [](Op op, void* ptr) noexcept(true) {
+                auto& target = *static_cast<D*>(ptr);
+                if (op == Op::Run) {
+                    target();
+                }
+                target.~D();
+            },
+            used_,
+            static_cast<Mark>(targetOffset),
+        };
+        used_ = static_cast<Mark>(end);
+    }
+
+    // Returns the current position, which can later be passed to rollbackTo() to execute
+    // only the targets registered after this call.
+    Mark mark() const noexcept {
+        return used_;
+    }
+
+    // Executes (in reverse) all the targets registered after the given mark.
+    void rollbackTo(Mark mark) noexcept {
+        assert(mark <= used_);
+        unwind(mark, Op::Run);
+    }
+
+    // Drops all the registered targets without executing them.
+    void commit() noexcept {
+        unwind(0, Op::Destroy);
+    }
+
+    bool empty() const noexcept {
+        return used_ == 0;
+    }
+
+    // Number of bytes of the buffer in use, including per-target bookkeeping
+    std::size_t size() const noexcept {
+        return used_;
+    }
+
+    static constexpr std::size_t capacity() noexcept {
+        return Bytes;
+    }
+
+private:
+    static_assert(Bytes <= std::numeric_limits<Mark>::max());
+
+    enum class Op {
+        Run,
+        Destroy,
+    };
+
+    struct Footer {
+        void(*trampoline)(Op, void*);
+        // Position of the stack before this target was registered
+        Mark begin;
+        Mark target;
+    };
+
+    static constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment) noexcept {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    void unwind(Mark mark, Op op) noexcept {
+        while (used_ > mark) {
+            const auto end = used_;
+            auto& footer = *reinterpret_cast<Footer*>(&storage_[end - sizeof(Footer)]);
+            // The target runs in place and is only popped once it returns, so a target which defers
+            // more work pushes it above its own live storage. That work is then unwound first, and
+            // the finished entry (its trampoline cleared) is popped once it's back on top.
+            if (auto trampoline = std::exchange(footer.trampoline, nullptr)) {
+                trampoline(op, &storage_[footer.target]);
+            }
+            if (used_ == end && !footer.trampoline) {
+                used_ = footer.begin;
+            }
+        }
+    }
+
+    constexpr void checkSize(std::size_t end) noexcept(!PerformBoundsCheck) {
+        if constexpr (PerformBoundsCheck) {
+            if (end > Bytes) {
+                throw std::runtime_error("Capacity exceeded");
+            }
+        } else {
+            assert(end <= Bytes);
+        }
+    }
+
+    alignas(std::max_align_t) std::byte storage_[Bytes];
+    Mark used_ = 0;
+};
+}
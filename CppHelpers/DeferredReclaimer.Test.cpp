@@ -0,0 +1,98 @@
+//
+//  DeferredReclaimer.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "DeferredReclaimer.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("[DeferredReclaimer] executes guards on the reclaimer thread") {
+    sh::DeferredReclaimer reclaimer;
+    std::thread::id executedOn;
+    {
+        auto guard = sh::makeDeferredGuard(reclaimer, [&executedOn]() noexcept {
+            executedOn = std::this_thread::get_id();
+        });
+    }
+    reclaimer.flush();
+    REQUIRE(executedOn != std::thread::id{});
+    REQUIRE(executedOn != std::this_thread::get_id());
+}
+
+TEST_CASE("[DeferredReclaimer] flush waits for guards retired from all threads") {
+    sh::DeferredReclaimer::Options options;
+    options.capacity = 4096;
+    options.batchSize = 16;
+    sh::DeferredReclaimer reclaimer(options);
+    
+    std::atomic<int> count{0};
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; i++) {
+        producers.emplace_back([&]() {
+            for (int j = 0; j < 500; j++) {
+                reclaimer.retire(sh::makeGuard([&count]() noexcept { count++; }));
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    reclaimer.flush();
+    REQUIRE(count == 2000);
+    REQUIRE(reclaimer.inlineExecutions() == 0);
+}
+
+TEST_CASE("[DeferredReclaimer] destroying the reclaimer executes pending guards") {
+    auto ptr = std::make_shared<int>(10);
+    {
+        sh::DeferredReclaimer reclaimer;
+        for (int i = 0; i < 10; i++) {
+            auto guard = sh::makeDeferredGuard(reclaimer, [ptr]() noexcept {});
+        }
+    }
+    REQUIRE(ptr.use_count() == 1);
+}
+
+TEST_CASE("[DeferredReclaimer] full queue falls back to inline execution") {
+    sh::DeferredReclaimer::Options options;
+    options.capacity = 2;
+    options.batchSize = 1;
+    sh::DeferredReclaimer reclaimer(options);
+    
+    // Keep the reclaimer thread busy so that the queue fills up
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    reclaimer.retire(sh::makeGuard([&]() noexcept {
+        started = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    }));
+    while (!started) {
+        std::this_thread::yield();
+    }
+    
+    int inlineCount = 0;
+    const auto self = std::this_thread::get_id();
+    for (int i = 0; i < 4; i++) {
+        reclaimer.retire(sh::makeGuard([&inlineCount, self]() noexcept {
+            if (std::this_thread::get_id() == self) {
+                inlineCount++;
+            }
+        }));
+    }
+    REQUIRE(inlineCount == 2);
+    REQUIRE(reclaimer.inlineExecutions() == 2);
+    
+    release = true;
+    reclaimer.flush();
+}
@@ -0,0 +1,238 @@
+//
+//  DeferredReclaimer.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Guard.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+// Moves expensive cleanup (freeing large buffers, munmap, close etc.) off latency critical
+// threads. Guards are handed over through a bounded lock-free queue and executed in batches
+// on a background thread.
+// Example :
+// DeferredReclaimer reclaimer;
+// void onRequest() {
+//     auto buffer = allocateLargeBuffer();
+//     auto guard = makeDeferredGuard(reclaimer, [buffer]() noexcept { free(buffer); });
+//     // ... the free happens on the reclaimer thread once guard goes out of scope
+// }
+// Backpressure : the queue has a fixed capacity. If the reclaimer falls behind and the queue
+// is full, the guard executes inline on the calling thread instead of blocking it.
+// Note that guards allocated on one thread and freed on the reclaimer thread end up on the
+// reclaimer's free list (see FreeListPool), so producers don't benefit from guard pooling.
+class DeferredReclaimer : NonCopyable, NonMovable {
+public:
+    struct Options {
+        // Rounded up to a power of two
+        std::size_t capacity = 1024;
+        // The reclaimer thread is woken up once this many guards are pending ...
+        std::size_t batchSize = 64;
+        // ... or after this interval, whichever comes first.
+        std::chrono::milliseconds interval{10};
+    };
+
+    DeferredReclaimer() : DeferredReclaimer(Options{}) {}
+
+    explicit DeferredReclaimer(Options options)
+        : capacity_(roundUpToPowerOfTwo(options.capacity)),
+          batchSize_(options.batchSize),
+          interval_(options.interval),
+          cells_(new Cell[capacity_]) {
+        assert(batchSize_ > 0);
+        for (std::size_t i = 0; i < capacity_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    // Executes everything that is still pending before returning.
+    ~DeferredReclaimer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeup_.notify_one();
+        thread_.join();
+    }
+
+    // Takes ownership of the guard, which is then destroyed (ie. its target executed) on the
+    // reclaimer thread. Never blocks.
+    void retire(GuardKey guard) noexcept {
+        if (!guard) {
+            return;
+        }
+        std::size_t ticket;
+        if (!tryPush(guard.get(), ticket)) {
+            // Queue is full, execute inline rather than block the producer
+            inlineExecutions_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        guard.release();
+        // Only wake the reclaimer once per batch, the rest gets picked up on the next wakeup
+        if ((ticket + 1) % batchSize_ == 0) {
+            wakeup_.notify_one();
+        }
+    }
+
+    // Blocks until every guard retired before this call (on any thread) has executed.
+    void flush() {
+        const auto target = enqueuePos_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        flushTarget_ = std::max(flushTarget_, target);
+        wakeup_.notify_one();
+        flushed_.wait(lock, [&]() { return completed_.load(std::memory_order_acquire) >= target; });
+    }
+
+    // Number of guards which couldn't be queued and executed on the calling thread instead
+    std::size_t inlineExecutions() const noexcept {
+        return inlineExecutions_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Bounded MPSC queue, based on Dmitry Vyukov's bounded MPMC queue. Every cell carries a
+    // sequence number which tells producers and the consumer whose turn it is, so enqueue is
+    // a single CAS on the happy path.
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        GuardBase* guard;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) noexcept {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    bool tryPush(GuardBase* guard, std::size_t& ticket) noexcept {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos & (capacity_ - 1)];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.guard = guard;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    ticket = pos;
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only called from the reclaimer thread
+    bool tryPop(GuardBase*& guard) noexcept {
+        auto& cell = cells_[dequeuePos_ & (capacity_ - 1)];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeuePos_ + 1) {
+            return false;
+        }
+        guard = cell.guard;
+        cell.sequence.store(dequeuePos_ + capacity_, std::memory_order_release);
+        dequeuePos_++;
+        return true;
+    }
+
+    // Drains the queue and returns whether anything was executed. A producer which has claimed
+    // a slot but not yet published it stops the drain, it gets picked up on the next round.
+    bool drain() noexcept {
+        bool executed = false;
+        GuardBase* guard;
+        while (tryPop(guard)) {
+            delete guard;
+            completed_.store(dequeuePos_, std::memory_order_release);
+            executed = true;
+        }
+        return executed;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            const bool stopping = stopping_;
+            lock.unlock();
+            const bool executed = drain();
+            lock.lock();
+            // Flush requests are acknowledged once, not on every round after the first flush
+            if (executed || flushTarget_ > acknowledgedFlush_) {
+                acknowledgedFlush_ = flushTarget_;
+                flushed_.notify_all();
+            }
+            const auto pending = enqueuePos_.load(std::memory_order_acquire) != dequeuePos_;
+            if (stopping && !pending) {
+                return;
+            }
+            if (pending && (stopping || flushTarget_ > dequeuePos_)) {
+                // Someone is waiting on a slot which is claimed but not published yet
+                lock.unlock();
+                std::this_thread::yield();
+                lock.lock();
+                continue;
+            }
+            wakeup_.wait_for(lock, interval_);
+        }
+    }
+
+    const std::size_t capacity_;
+    const std::size_t batchSize_;
+    const std::chrono::milliseconds interval_;
+    std::unique_ptr<Cell[]> cells_;
+
+    // Keep the producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::size_t dequeuePos_ = 0;
+    std::atomic<std::size_t> completed_{0};
+    std::atomic<std::size_t> inlineExecutions_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable flushed_;
+    std::size_t flushTarget_ = 0;
+    // Only used by the reclaimer thread, under mutex_
+    std::size_t acknowledgedFlush_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// Deleter which hands the guard over to a DeferredReclaimer instead of destroying it inline
+struct DeferredGuardDeleter {
+    DeferredReclaimer* reclaimer = nullptr;
+
+    void operator()(GuardBase* guard) const noexcept {
+        assert(reclaimer);
+        reclaimer->retire(GuardKey(guard));
+    }
+};
+
+using DeferredGuardKey = std::unique_ptr<GuardBase, DeferredGuardDeleter>;
+
+// Same as makeGuard, but the target executes on the reclaimer's thread once the returned
+// key is destroyed.
+template <typename T>
+auto makeDeferredGuard(DeferredReclaimer& reclaimer, T&& target) {
+    return DeferredGuardKey(new Guard(std::forward<T>(target)), DeferredGuardDeleter{&reclaimer});
+}
+}
@@ -0,0 +1,47 @@
+//
+//  Epoch.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "Epoch.h"
+#include "HazardPointer.h"
+
+#include <atomic>
+#include <memory>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("Epoch read-side overhead", "[!benchmark][Epoch]") {
+    struct Node {
+        int value;
+    };
+    
+    sh::Epoch domain;
+    std::atomic<Node*> head{new Node{1}};
+    BENCHMARK("EpochGuard") {
+        sh::EpochGuard guard(domain);
+        return head.load(std::memory_order_acquire)->value;
+    };
+    
+    sh::HazardDomain hazardDomain;
+    BENCHMARK("HazardGuard") {
+        sh::HazardGuard guard(hazardDomain);
+        return guard.protect(head)->value;
+    };
+    
+    auto shared = std::make_shared<Node>(Node{1});
+    BENCHMARK("shared_ptr copy") {
+        auto copy = std::atomic_load(&shared);
+        return copy->value;
+    };
+    
+    BENCHMARK("unprotected load (baseline)") {
+        return head.load(std::memory_order_acquire)->value;
+    };
+    delete head.load();
+}
@@ -0,0 +1,134 @@
+//
+//  Epoch.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "Epoch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Tracked {
+    static inline std::atomic<int> alive{0};
+    Tracked(int v = 0) : value(v) { alive++; }
+    ~Tracked() { alive--; }
+    int value;
+};
+}
+
+TEST_CASE("[Epoch] retired objects are eventually freed") {
+    {
+        sh::Epoch domain;
+        for (int i = 0; i < 1000; i++) {
+            domain.retire(new Tracked(i));
+        }
+        // Nobody is pinned, so amortized reclamation keeps the limbo list bounded
+        REQUIRE(Tracked::alive < static_cast<int>(sh::Epoch::LimboCapacity));
+        domain.collect();
+        domain.collect();
+        domain.collect();
+        REQUIRE(Tracked::alive == 0);
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[Epoch] pinned readers block reclamation") {
+    sh::Epoch domain;
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&]() {
+        sh::EpochGuard guard(domain);
+        pinned = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned) {
+        std::this_thread::yield();
+    }
+    
+    domain.retire(new Tracked());
+    for (int i = 0; i < 10; i++) {
+        domain.collect();
+    }
+    REQUIRE(Tracked::alive == 1);
+    
+    release = true;
+    reader.join();
+    for (int i = 0; i < 3; i++) {
+        domain.collect();
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[Epoch] guards can be nested") {
+    sh::Epoch domain;
+    {
+        sh::EpochGuard outer(domain);
+        {
+            sh::EpochGuard inner(domain);
+        }
+        // Still pinned by the outer guard, retiring from within a pinned section is allowed
+        domain.retire(new Tracked());
+        for (int i = 0; i < 10; i++) {
+            domain.collect();
+        }
+        REQUIRE(Tracked::alive == 1);
+    }
+    for (int i = 0; i < 3; i++) {
+        domain.collect();
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[Epoch] stalled readers spill limbo to the heap without leaking") {
+    {
+        sh::Epoch domain;
+        sh::EpochGuard guard(domain);
+        for (std::size_t i = 0; i < 4 * sh::Epoch::LimboCapacity; i++) {
+            domain.retire(new Tracked());
+        }
+        REQUIRE(Tracked::alive > static_cast<int>(sh::Epoch::LimboCapacity));
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[Epoch] concurrent readers and writers") {
+    struct Node {
+        int value;
+    };
+    sh::Epoch domain;
+    std::atomic<Node*> head{new Node{0}};
+    std::atomic<bool> done{false};
+    std::atomic<bool> corrupted{false};
+    
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                sh::EpochGuard guard(domain);
+                auto node = head.load(std::memory_order_acquire);
+                if (node->value < 0) {
+                    corrupted = true;
+                }
+            }
+        });
+    }
+    for (int i = 1; i < 5000; i++) {
+        auto old = head.exchange(new Node{i}, std::memory_order_acq_rel);
+        domain.retire(old);
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    delete head.load();
+    REQUIRE(!corrupted);
+}
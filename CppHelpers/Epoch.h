@@ -0,0 +1,199 @@
+//
+//  Epoch.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ArrayVector.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "ThreadRecords.h"
+
+namespace sh {
+// Epoch based memory reclamation domain for lock-free data structures.
+// Readers pin the domain (see EpochGuard) for as long as they hold pointers into the structure.
+// Writers unlink nodes and retire() them, a retired node is only deleted once every thread
+// which could still be reading it has unpinned.
+// Example :
+// Epoch domain;
+// int read(std::atomic<Node*>& head) {
+//     EpochGuard guard(domain);
+//     return head.load()->value;
+// }
+// void update(std::atomic<Node*>& head, Node* node) {
+//     auto old = head.exchange(node);
+//     domain.retire(old);
+// }
+// Retired nodes sit in a per-thread limbo list tagged with the global epoch at the time of
+// retirement. Every ReclaimInterval retirements, the thread tries to advance the global epoch
+// and frees whatever is two epochs old. The limbo list is an inline ArrayVector, it only spills
+// to the heap if readers stall reclamation for long enough to fill it up.
+// The domain must outlive all pins and retirements, and is limited to MaxThreads threads
+// using it concurrently (records of exited threads are reused).
+class Epoch : NonCopyable, NonMovable {
+public:
+    static constexpr std::size_t MaxThreads = 128;
+    static constexpr std::size_t LimboCapacity = 128;
+    static constexpr std::size_t ReclaimInterval = 32;
+
+    Epoch() = default;
+
+    // No thread may be pinned when the domain is destroyed. Everything still in limbo is freed.
+    ~Epoch() {
+        const auto count = records_.count();
+        for (std::size_t i = 0; i < count; i++) {
+            auto& record = records_[i];
+            assert(record.nesting == 0);
+            for (auto& retired : record.limbo) {
+                retired.deleter(retired.ptr);
+            }
+            for (auto& retired : record.overflow) {
+                retired.deleter(retired.ptr);
+            }
+        }
+    }
+
+    // Hands ptr over to the domain, deleter(ptr) is called once no reader can reference it.
+    // ptr must already be unreachable for new readers.
+    void retire(void* ptr, void(*deleter)(void*)) {
+        auto& record = records_.local();
+        const auto epoch = globalEpoch_.load(std::memory_order_acquire);
+        if (record.limbo.size() == record.limbo.capacity()) {
+            reclaim(record);
+        }
+        if (record.limbo.size() < record.limbo.capacity()) {
+            record.limbo.push_back({ptr, deleter, epoch});
+        } else {
+            record.overflow.push_back({ptr, deleter, epoch});
+        }
+        if (++record.sinceReclaim >= ReclaimInterval) {
+            reclaim(record);
+        }
+    }
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // Tries to advance the epoch and frees whatever the calling thread has retired that is no
+    // longer reachable. This happens automatically as part of retire().
+    void collect() {
+        reclaim(records_.local());
+    }
+
+    std::uint64_t epoch() const noexcept {
+        return globalEpoch_.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class EpochGuard;
+
+    // Bit 0 is set while the thread is pinned, the remaining bits hold the epoch observed at
+    // pin time.
+    static constexpr std::uint64_t PinnedBit = 1;
+
+    struct Retired {
+        void* ptr;
+        void(*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    // Aligned to a cache line since the state is written on every pin
+    struct alignas(64) Record {
+        std::atomic<std::uint64_t> state{0};
+        // Only ever touched by the owning thread
+        std::uint32_t nesting = 0;
+        std::uint32_t sinceReclaim = 0;
+        ArrayVector<Retired, LimboCapacity> limbo;
+        std::vector<Retired> overflow;
+    };
+
+    void pin(Record& record) noexcept {
+        if (record.nesting++ == 0) {
+            const auto epoch = globalEpoch_.load(std::memory_order_relaxed);
+            record.state.store((epoch << 1) | PinnedBit, std::memory_order_relaxed);
+            // The pin must be visible before we read any shared pointers, otherwise a writer
+            // could advance the epoch twice and free something we are about to read.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void unpin(Record& record) noexcept {
+        assert(record.nesting > 0);
+        if (--record.nesting == 0) {
+            record.state.store(0, std::memory_order_release);
+        }
+    }
+
+    // The epoch can only advance once every pinned thread has observed the current one.
+    void tryAdvance() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto epoch = globalEpoch_.load(std::memory_order_relaxed);
+        const auto count = records_.count();
+        for (std::size_t i = 0; i < count; i++) {
+            const auto state = records_[i].state.load(std::memory_order_acquire);
+            if ((state & PinnedBit) && (state >> 1) != epoch) {
+                return;
+            }
+        }
+        // Losing the race is fine, someone else advanced it for us
+        auto expected = epoch;
+        globalEpoch_.compare_exchange_strong(expected, epoch + 1, std::memory_order_acq_rel);
+    }
+
+    void reclaim(Record& record) {
+        record.sinceReclaim = 0;
+        tryAdvance();
+        // Something retired in epoch e can still be read by threads pinned in e - 1 or e, which
+        // are guaranteed to be gone once the global epoch reaches e + 2.
+        const auto epoch = globalEpoch_.load(std::memory_order_acquire);
+        auto isSafe = [epoch](const Retired& retired) { return retired.epoch + 2 <= epoch; };
+
+        // Entries are in retirement order, so the reclaimable ones form a prefix
+        auto end = std::find_if_not(record.limbo.begin(), record.limbo.end(), isSafe);
+        for (auto it = record.limbo.begin(); it != end; ++it) {
+            it->deleter(it->ptr);
+        }
+        record.limbo.erase(record.limbo.begin(), end);
+
+        auto overflowEnd = std::find_if_not(record.overflow.begin(), record.overflow.end(), isSafe);
+        for (auto it = record.overflow.begin(); it != overflowEnd; ++it) {
+            it->deleter(it->ptr);
+        }
+        record.overflow.erase(record.overflow.begin(), overflowEnd);
+    }
+
+    detail::ThreadRecords<Record, MaxThreads> records_;
+    alignas(64) std::atomic<std::uint64_t> globalEpoch_{0};
+};
+
+// Pins the epoch domain for the lifetime of the guard, so that nothing retired from now on
+// is freed while the guard is alive. Guards can be nested.
+// Like StackGuard, this is meant for scope-based usage.
+class EpochGuard : NonCopyable, NonMovable {
+public:
+    explicit EpochGuard(Epoch& domain) : domain_(domain), record_(domain.records_.local()) {
+        domain_.pin(record_);
+    }
+
+    ~EpochGuard() {
+        domain_.unpin(record_);
+    }
+
+private:
+    Epoch& domain_;
+    Epoch::Record& record_;
+};
+}
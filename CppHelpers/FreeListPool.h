@@ -0,0 +1,124 @@
+//
+//  FreeListPool.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+// Used for slow or shared paths which shouldn't be inlined into every caller
+#if defined(_MSC_VER)
+#define SH_NOINLINE __declspec(noinline)
+#else
+#define SH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace sh {
+namespace detail {
+// Rounds a block size up to the next power of two (minimum 32 bytes). Keeping the number
+// of distinct size classes small means that differently sized targets end up sharing the
+// same free list instead of each instantiation keeping its own cache of blocks.
+constexpr std::size_t PoolSizeClass(std::size_t size) {
+    std::size_t sizeClass = 32;
+    while (sizeClass < size) {
+        sizeClass <<= 1;
+    }
+    return sizeClass;
+}
+
+static_assert(PoolSizeClass(1) == 32);
+static_assert(PoolSizeClass(33) == 64);
+static_assert(PoolSizeClass(256) == 256);
+
+// Guards which are very large or over-aligned aren't worth caching, so they go straight
+// to the global allocator.
+constexpr std::size_t MaxPooledGuardSize = 256;
+}
+
+// Per-thread free list of fixed size blocks. Blocks are obtained from the global allocator
+// the first time and then recycled, so steady-state allocate/deallocate pairs never touch
+// the global allocator (and never take a lock).
+// A block may be freed on a different thread than the one that allocated it, in which case
+// it simply ends up on the freeing thread's list. Every list caches at most MaxCached blocks,
+// beyond that blocks are returned to the global allocator.
+// allocate() and deallocate() are kept out of line since they're shared by everything in the
+// same size class, inlining them would duplicate the TLS access and branches in every caller.
+template <std::size_t BlockSize, std::size_t MaxCached = 64>
+class FreeListPool : NonCopyable, NonMovable {
+public:
+    static constexpr std::size_t Size = BlockSize;
+    static constexpr std::size_t Alignment = alignof(std::max_align_t);
+
+    SH_NOINLINE static void* allocate() {
+        auto& list = freeList();
+        if (list.head) {
+            auto node = list.head;
+            list.head = node->next;
+            list.count--;
+            return node;
+        }
+        return ::operator new(BlockSize);
+    }
+
+    SH_NOINLINE static void deallocate(void* ptr) noexcept {
+        auto& list = freeList();
+        if (list.closed || list.count >= MaxCached) {
+            ::operator delete(ptr);
+            return;
+        }
+        // Only register the drainer once we actually cache something. Threads which never
+        // free a pooled block don't pay for the thread exit registration.
+        static thread_local Drainer drainer;
+        (void)drainer;
+        list.head = new (ptr) Node{list.head};
+        list.count++;
+    }
+
+    // Number of blocks currently cached on this thread
+    static std::size_t cached() noexcept {
+        return freeList().count;
+    }
+
+private:
+    static_assert(BlockSize >= sizeof(void*), "Blocks must be large enough to hold a list node");
+
+    struct Node {
+        Node* next;
+    };
+
+    // This is kept trivially destructible so that it remains usable during thread exit, ie.
+    // blocks freed after the drainer has run (eg. from other thread_local destructors) go
+    // straight back to the global allocator.
+    struct FreeList {
+        Node* head;
+        std::size_t count;
+        bool closed;
+    };
+
+    struct Drainer {
+        ~Drainer() {
+            auto& list = freeList();
+            while (list.head) {
+                auto node = list.head;
+                list.head = node->next;
+                ::operator delete(node);
+            }
+            list.count = 0;
+            list.closed = true;
+        }
+    };
+
+    static FreeList& freeList() noexcept {
+        static thread_local FreeList list{};
+        return list;
+    }
+};
+}
@@ -0,0 +1,109 @@
+//
+//  FunctionRef.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "FunctionRef.h"
+#include "Variant.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+int twice(int x) {
+    return 2 * x;
+}
+
+long square(long x) noexcept {
+    return x * x;
+}
+
+constexpr sh::FunctionRef<int(int)> TwiceRef = &twice;
+
+// A non-template entry point, callers with different lambdas share a single instantiation
+int sumMapped(const std::vector<int>& values, sh::FunctionRef<int(int)> fn) {
+    int sum = 0;
+    for (auto value : values) {
+        sum += fn(value);
+    }
+    return sum;
+}
+
+std::string describe(const sh::Variant<int, std::string>& v) {
+    return sh::visitRef<std::string>(v,
+        [](const int& i) { return "int " + std::to_string(i); },
+        [](const std::string& s) { return "string " + s; });
+}
+}
+
+TEST_CASE("[FunctionRef] static asserts") {
+    using Ref = sh::FunctionRef<int(int)>;
+    static_assert(std::is_trivially_copyable_v<Ref>);
+    static_assert(sizeof(Ref) == 2 * sizeof(void*));
+    static_assert(!std::is_default_constructible_v<Ref>);
+    static_assert(std::is_constructible_v<Ref, long (*)(long) noexcept>);
+    static_assert(!std::is_constructible_v<Ref, void (*)()>);
+    static_assert(!std::is_constructible_v<Ref, std::string>);
+}
+
+TEST_CASE("[FunctionRef] invokes callables") {
+    SECTION("Function pointers") {
+        REQUIRE(TwiceRef(3) == 6);
+        sh::FunctionRef<int(int)> ref = square;
+        REQUIRE(ref(3) == 9);
+    }
+
+    SECTION("Lambdas are referenced, not copied") {
+        int calls = 0;
+        auto lambda = [&calls, offset = 1](int x) mutable { calls++; return x + offset++; };
+        sh::FunctionRef<int(int)> ref = lambda;
+        REQUIRE(ref(1) == 2);
+        REQUIRE(lambda(1) == 3);
+        REQUIRE(ref(1) == 4);
+        REQUIRE(calls == 3);
+    }
+
+    SECTION("Copies refer to the same callable") {
+        int calls = 0;
+        auto lambda = [&calls]() { calls++; };
+        sh::FunctionRef<void()> first = lambda;
+        auto second = first;
+        first();
+        second();
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("Void signatures discard the result") {
+        int calls = 0;
+        auto lambda = [&calls](int x) { return calls += x; };
+        sh::FunctionRef<void(int)> ref = lambda;
+        ref(2);
+        REQUIRE(calls == 2);
+        sh::FunctionRef<void(int)> function = &twice;
+        function(1);
+        sh::FunctionRef<void()> exact = []() {};
+        exact();
+    }
+
+    SECTION("Temporaries as arguments") {
+        std::vector<int> values{1, 2, 3};
+        REQUIRE(sumMapped(values, [](int x) { return x * 10; }) == 60);
+        REQUIRE(sumMapped(values, &twice) == 12);
+    }
+}
+
+TEST_CASE("[FunctionRef] type-erased variant visit") {
+    sh::Variant<int, std::string> v = 5;
+    REQUIRE(describe(v) == "int 5");
+    v = std::string("text");
+    REQUIRE(describe(v) == "string text");
+
+    sh::visitRef(v, [](int& i) { i++; }, [](std::string& s) { s += "!"; });
+    REQUIRE(v.get<std::string>() == "text!");
+}
@@ -0,0 +1,114 @@
+//
+//  FunctionRef.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace sh {
+template <typename Signature>
+class FunctionRef;
+
+// Non-owning reference to a callable, for callbacks which are only used for the duration of a
+// call (visitors, comparators, per-element hooks). It is two words (the callable's address and
+// a capture-less trampoline which knows its type), never allocates, and is trivially copyable,
+// so it is passed in registers like a pointer.
+// Unlike a template parameter, taking a FunctionRef doesn't instantiate the callee once per
+// lambda, so it can be used for non-template entry points (see visitRef in Variant.h).
+// Like std::string_view, the referenced callable must outlive the FunctionRef. Binding to a
+// temporary is fine when the FunctionRef is a function parameter, but storing one is a bug :
+// void forEachChild(FunctionRef<void(Node&)> fn);
+// forEachChild([&](Node& node) { count++; });     // Fine, the lambda outlives the call
+// FunctionRef<void(Node&)> ref = [&](Node&) {};   // Dangles after the semicolon
+// Function pointers are stored by value, so they don't have to outlive the reference.
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    // Exact matches can be constructed at compile time
+    constexpr FunctionRef(R (*function)(Args...)) noexcept
+        : target_(function), trampoline_(&callFunction) {
+        assert(function != nullptr);
+    }
+
+    // Function pointers with a compatible signature, eg. noexcept functions or convertible
+    // parameter types
+    template <typename F,
+              typename = std::enable_if_t<std::is_function_v<F> && !std::is_same_v<F, R(Args...)> &&
+                                          std::is_invocable_r_v<R, F*, Args...>>>
+    FunctionRef(F* function) noexcept
+        : target_(Erased{}, reinterpret_cast<void (*)()>(function)), trampoline_(&callFunctionAs<F>) {
+        assert(function != nullptr);
+    }
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                                          !std::is_function_v<std::remove_reference_t<F>> &&
+                                          !std::is_pointer_v<std::decay_t<F>> &&
+                                          std::is_invocable_r_v<R, F&, Args...>>>
+    constexpr FunctionRef(F&& callable) noexcept
+        : target_(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+          trampoline_(&callObject<std::remove_reference_t<F>>) {}
+
+    FunctionRef(const FunctionRef&) noexcept = default;
+    FunctionRef& operator=(const FunctionRef&) noexcept = default;
+
+    R operator()(Args... args) const {
+        return trampoline_(target_, std::forward<Args>(args)...);
+    }
+
+private:
+    // Objects are referenced by address, functions by value. Callables are always bound, so
+    // there is no empty state and calling doesn't need a check.
+    struct Erased {};
+
+    union Target {
+        constexpr Target(void* object) noexcept : object(object) {}
+        constexpr Target(R (*function)(Args...)) noexcept : function(function) {}
+        constexpr Target(Erased, void (*erased)()) noexcept : erased(erased) {}
+
+        void* object;
+        R (*function)(Args...);
+        // Function pointers with a compatible signature. void (*)() is the type function pointers
+        // are cast through, the cast to and from it doesn't trigger -Wcast-function-type.
+        void (*erased)();
+    };
+
+    using Trampoline = R (*)(Target, Args&&...);
+
+    // Void signatures accept callables which return something, the result is discarded
+    template <typename F>
+    static R invoke(F&& callable, Args&&... args) {
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(std::forward<F>(callable), std::forward<Args>(args)...);
+        } else {
+            return std::invoke(std::forward<F>(callable), std::forward<Args>(args)...);
+        }
+    }
+
+    static R callFunction(Target target, Args&&... args) {
+        return target.function(std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static R callFunctionAs(Target target, Args&&... args) {
+        return invoke(reinterpret_cast<F*>(target.erased), std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static R callObject(Target target, Args&&... args) {
+        return invoke(*static_cast<F*>(target.object), std::forward<Args>(args)...);
+    }
+
+    Target target_;
+    Trampoline trampoline_;
+};
+}
@@ -0,0 +1,144 @@
+//
+//  Guard.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "Guard.h"
+
+#include <functional>
+#include <memory>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("Guard creation and destruction", "[!benchmark][GuardKey]") {
+    int calls = 0;
+    
+    // The claim behind the pooled benchmarks : once a block has been cached, creating and
+    // destroying guards recycles it instead of going to the global allocator, ie. the thread's
+    // free list neither grows (nothing was allocated) nor shrinks (nothing was kept) per guard.
+    using Pool = sh::FreeListPool<32>;
+    {
+        auto guard = sh::makeGuard([&calls]() noexcept(true) { calls++; });
+        auto handle = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+    }
+    const auto cached = Pool::cached();
+    REQUIRE(cached >= 2);
+    for (int i = 0; i < 1000; i++) {
+        auto guard = sh::makeGuard([&calls]() noexcept(true) { calls++; });
+        auto handle = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        REQUIRE(Pool::cached() == cached - 2);
+    }
+    REQUIRE(Pool::cached() == cached);
+    
+    BENCHMARK("makeGuard (pooled)") {
+        auto guard = sh::makeGuard([&calls]() noexcept(true) { calls++; });
+        guard = nullptr;
+        return calls;
+    };
+    
+    BENCHMARK("makeGuardHandle (pooled, no vtable)") {
+        auto guard = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        guard = nullptr;
+        return calls;
+    };
+    
+    // Illustrative comparison only, not the previous makeGuard : a std::function boxed in a
+    // unique_ptr, both allocated through the global allocator.
+    BENCHMARK("unique_ptr<std::function> (global allocator, illustrative)") {
+        auto target = std::make_unique<std::function<void()>>([&calls]() noexcept(true) { calls++; });
+        (*target)();
+        target = nullptr;
+        return calls;
+    };
+    
+    BENCHMARK("StackGuard (baseline)") {
+        {
+            auto guard = sh::StackGuard([&calls]() noexcept(true) { calls++; });
+        }
+        return calls;
+    };
+}
+
+TEST_CASE("Conditional guards on the success path", "[!benchmark][ScopeFail][ScopeSuccess]") {
+    int calls = 0;
+    
+    BENCHMARK("ScopeFail") {
+        sh::ScopeFail guard([&calls]() noexcept(true) { calls--; });
+        calls++;
+        return calls;
+    };
+    
+    BENCHMARK("hand-written try/catch") {
+        try {
+            calls++;
+        } catch (...) {
+            calls--;
+            throw;
+        }
+        return calls;
+    };
+    
+    BENCHMARK("ScopeSuccess") {
+        {
+            sh::ScopeSuccess guard([&calls]() noexcept(true) { calls++; });
+        }
+        return calls;
+    };
+}
+
+// Cleanup heavy code, several resources acquired in one scope and released in reverse order
+TEST_CASE("Many guards per scope", "[!benchmark][StackGuard][GuardKey][GuardHandle][InplaceGuard]") {
+    int calls = 0;
+    
+    BENCHMARK("8 StackGuards") {
+        auto g0 = sh::StackGuard([&calls]() noexcept(true) { calls += 1; });
+        auto g1 = sh::StackGuard([&calls]() noexcept(true) { calls += 2; });
+        auto g2 = sh::StackGuard([&calls]() noexcept(true) { calls += 3; });
+        auto g3 = sh::StackGuard([&calls]() noexcept(true) { calls += 4; });
+        auto g4 = sh::StackGuard([&calls]() noexcept(true) { calls += 5; });
+        auto g5 = sh::StackGuard([&calls]() noexcept(true) { calls += 6; });
+        auto g6 = sh::StackGuard([&calls]() noexcept(true) { calls += 7; });
+        auto g7 = sh::StackGuard([&calls]() noexcept(true) { calls += 8; });
+        return calls;
+    };
+    
+    BENCHMARK("8 InplaceGuards") {
+        sh::InplaceGuard<16> guards[8];
+        for (int i = 0; i < 8; i++) {
+            guards[i].reset([&calls, i]() noexcept(true) { calls += i + 1; });
+        }
+        return calls;
+    };
+    
+    BENCHMARK("8 makeGuards") {
+        sh::GuardKey guards[8];
+        for (int i = 0; i < 8; i++) {
+            guards[i] = sh::makeGuard([&calls, i]() noexcept(true) { calls += i + 1; });
+        }
+        return calls;
+    };
+    
+    BENCHMARK("8 GuardHandles") {
+        sh::GuardHandle guards[8];
+        for (int i = 0; i < 8; i++) {
+            guards[i] = sh::makeGuardHandle([&calls, i]() noexcept(true) { calls += i + 1; });
+        }
+        return calls;
+    };
+    
+    BENCHMARK("8 std::functions") {
+        std::function<void()> targets[8];
+        for (int i = 0; i < 8; i++) {
+            targets[i] = [&calls, i]() noexcept(true) { calls += i + 1; };
+        }
+        for (int i = 7; i >= 0; i--) {
+            targets[i]();
+        }
+        return calls;
+    };
+}
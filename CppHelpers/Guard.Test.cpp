@@ -10,6 +10,8 @@
 
 #include "Guard.h"
 
+#include <array>
+#include <cstdint>
 #include <typeinfo>
 #include <type_traits>
 
@@ -155,6 +157,15 @@ TEST_CASE("Guard created on heap", "[GuardBase]") {
         }
     }
     
+    SECTION("Dismissing releases the target") {
+        auto owner = std::make_shared<int>(10);
+        std::weak_ptr<int> weakPtr = owner;
+        Holder h;
+        h.guard = sh::makeGuard([ptr = std::move(owner)]() noexcept(true) {});
+        h.guard->dismiss();
+        REQUIRE(weakPtr.use_count() == 0);
+    }
+    
     SECTION("Target is deallocated") {
         auto owner = std::make_shared<int>(10);
         std::weak_ptr<int> weakPtr = owner;
@@ -168,3 +179,269 @@ TEST_CASE("Guard created on heap", "[GuardBase]") {
     }
 }
 
+
+TEST_CASE("Heap guards are pooled", "[GuardKey]") {
+    int calls = 0;
+    auto makeCounter = [&]() {
+        return sh::makeGuard([&calls]() noexcept(true) { calls++; });
+    };
+    
+    SECTION("Freed blocks are reused") {
+        auto guard = makeCounter();
+        const void* first = guard.get();
+        guard = nullptr;
+        REQUIRE(calls == 1);
+        
+        guard = makeCounter();
+        REQUIRE(guard.get() == first);
+        guard = nullptr;
+        REQUIRE(calls == 2);
+    }
+    
+    SECTION("Targets of different sizes share a size class") {
+        std::array<char, 8> small{};
+        std::array<char, 12> larger{};
+        auto g1 = sh::makeGuard([small]() noexcept(true) {});
+        const void* first = g1.get();
+        g1 = nullptr;
+        
+        auto g2 = sh::makeGuard([larger]() noexcept(true) {});
+        REQUIRE(g2.get() == first);
+    }
+    
+    SECTION("Over-aligned targets still work") {
+        struct alignas(64) Aligned {
+            void operator()() noexcept(true) { (*calls)++; }
+            int* calls;
+        };
+        auto guard = sh::makeGuard(Aligned{&calls});
+        REQUIRE(reinterpret_cast<std::uintptr_t>(guard.get()) % 64 == 0);
+        guard = nullptr;
+        REQUIRE(calls == 1);
+    }
+}
+
+TEST_CASE("Guard handle without a vtable", "[GuardHandle]") {
+    struct Holder {
+        sh::GuardHandle guard;
+    };
+    int calls = 0;
+    
+    REQUIRE(sizeof(sh::GuardHandle) == 2 * sizeof(void*));
+    
+    SECTION("Executes when reset") {
+        Holder h;
+        h.guard = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        REQUIRE(h.guard);
+        REQUIRE(calls == 0);
+        h.guard = nullptr;
+        REQUIRE_FALSE(h.guard);
+        REQUIRE(calls == 1);
+    }
+    
+    SECTION("Dismiss releases the target without running it") {
+        auto owner = std::make_shared<int>(10);
+        std::weak_ptr<int> weakPtr = owner;
+        auto guard = sh::makeGuardHandle([&calls, ptr = std::move(owner)]() noexcept(true) { calls++; });
+        REQUIRE(weakPtr.use_count() == 1);
+        guard.dismiss();
+        REQUIRE_FALSE(guard);
+        REQUIRE(weakPtr.use_count() == 0);
+        guard = nullptr;
+        REQUIRE(calls == 0);
+    }
+    
+    SECTION("Moving transfers the target") {
+        auto first = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        auto second = std::move(first);
+        REQUIRE_FALSE(first);
+        first = nullptr;
+        REQUIRE(calls == 0);
+        
+        second = sh::makeGuardHandle([&calls]() noexcept(true) { calls += 10; });
+        REQUIRE(calls == 1);
+        second = nullptr;
+        REQUIRE(calls == 11);
+    }
+    
+    SECTION("Storage is pooled") {
+        auto guard = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        const void* first = guard.get();
+        guard = nullptr;
+        guard = sh::makeGuardHandle([&calls]() noexcept(true) { calls++; });
+        REQUIRE(guard.get() == first);
+    }
+    
+    SECTION("Converts from makeGuard") {
+        Holder h;
+        h.guard = sh::makeGuard([&calls]() noexcept(true) { calls++; });
+        REQUIRE(h.guard);
+        h.guard = nullptr;
+        REQUIRE(calls == 1);
+        
+        auto owner = std::make_shared<int>(10);
+        std::weak_ptr<int> weakPtr = owner;
+        h.guard = sh::makeGuard([&calls, ptr = std::move(owner)]() noexcept(true) { calls++; });
+        h.guard.dismiss();
+        REQUIRE(weakPtr.use_count() == 0);
+        REQUIRE(calls == 1);
+    }
+}
+
+TEST_CASE("Guard stored inline", "[InplaceGuard]") {
+    using G = sh::InplaceGuard<24>;
+    static_assert(sizeof(G) == 24 + sizeof(void*));
+    static_assert(std::is_nothrow_move_constructible_v<G>);
+    static_assert(std::is_nothrow_move_assignable_v<G>);
+    static_assert(!std::is_copy_constructible_v<G>);
+    static_assert(!std::is_polymorphic_v<G>);
+    
+    SECTION("Executes on scope exit") {
+        int val = 1;
+        {
+            G guard([&]() noexcept(true) { val = 2; });
+            REQUIRE(val == 1);
+        }
+        REQUIRE(val == 2);
+    }
+    
+    SECTION("Can be used as a member") {
+        struct Holder {
+            G guard;
+        };
+        int val = 1;
+        {
+            Holder h;
+            REQUIRE(!h.guard);
+            h.guard = G([&]() noexcept(true) { val++; });
+            REQUIRE(h.guard);
+        }
+        REQUIRE(val == 2);
+    }
+    
+    SECTION("Moving transfers the target") {
+        int val = 0;
+        auto ptr = std::make_shared<int>(10);
+        {
+            G g1([&val, ptr]() noexcept(true) { val++; });
+            REQUIRE(ptr.use_count() == 2);
+            G g2(std::move(g1));
+            REQUIRE(!g1);
+            REQUIRE(g2);
+            REQUIRE(ptr.use_count() == 2);
+        }
+        REQUIRE(val == 1);
+        REQUIRE(ptr.use_count() == 1);
+    }
+    
+    SECTION("Move assignment runs the existing target") {
+        int a = 0;
+        int b = 0;
+        G g1([&a]() noexcept(true) { a++; });
+        G g2([&b]() noexcept(true) { b++; });
+        g1 = std::move(g2);
+        REQUIRE(a == 1);
+        REQUIRE(b == 0);
+        g1.reset();
+        REQUIRE(b == 1);
+        REQUIRE(!g1);
+    }
+    
+    SECTION("Dismiss destroys the target without running it") {
+        int val = 0;
+        auto ptr = std::make_shared<int>(10);
+        {
+            G guard([&val, ptr]() noexcept(true) { val++; });
+            guard.dismiss();
+            REQUIRE(ptr.use_count() == 1);
+        }
+        REQUIRE(val == 0);
+    }
+    
+    SECTION("Reset runs the old target and guards the new one") {
+        int a = 0;
+        int b = 0;
+        {
+            G guard([&a]() noexcept(true) { a++; });
+            guard.reset([&b]() noexcept(true) { b++; });
+            REQUIRE(a == 1);
+            REQUIRE(b == 0);
+        }
+        REQUIRE(a == 1);
+        REQUIRE(b == 1);
+    }
+}
+
+TEST_CASE("Guards conditional on exceptions", "[ScopeFail][ScopeSuccess]") {
+    static_assert(sizeof(sh::ScopeFail<void(*)() noexcept>) == 2 * sizeof(void*));
+    
+    SECTION("ScopeFail only executes during unwinding") {
+        int val = 0;
+        {
+            sh::ScopeFail guard([&]() noexcept(true) { val++; });
+        }
+        REQUIRE(val == 0);
+        
+        try {
+            sh::ScopeFail guard([&]() noexcept(true) { val++; });
+            throw std::runtime_error("");
+        } catch (std::exception&) {}
+        REQUIRE(val == 1);
+    }
+    
+    SECTION("ScopeSuccess only executes on normal exit") {
+        int val = 0;
+        {
+            sh::ScopeSuccess guard([&]() { val++; });
+        }
+        REQUIRE(val == 1);
+        
+        try {
+            sh::ScopeSuccess guard([&]() { val++; });
+            throw std::runtime_error("");
+        } catch (std::exception&) {}
+        REQUIRE(val == 1);
+    }
+    
+    SECTION("ScopeSuccess can throw") {
+        REQUIRE_THROWS_AS([]() {
+            sh::ScopeSuccess guard([]() { throw std::runtime_error(""); });
+        }(), std::runtime_error);
+    }
+    
+    SECTION("Dismissed guards don't execute") {
+        int val = 0;
+        try {
+            sh::ScopeFail guard([&]() noexcept(true) { val++; });
+            guard.dismiss();
+            throw std::runtime_error("");
+        } catch (std::exception&) {}
+        {
+            sh::ScopeSuccess guard([&]() { val++; });
+            guard.dismiss();
+        }
+        REQUIRE(val == 0);
+    }
+    
+    SECTION("Guards created while unwinding compare against their own scope") {
+        struct Unwinder {
+            ~Unwinder() {
+                // Created while an exception is already in flight, but this scope itself
+                // exits normally.
+                sh::ScopeFail fail([this]() noexcept(true) { (*failed)++; });
+                sh::ScopeSuccess success([this]() { (*succeeded)++; });
+            }
+            int* failed;
+            int* succeeded;
+        };
+        
+        int failed = 0;
+        int succeeded = 0;
+        try {
+            Unwinder u{&failed, &succeeded};
+            throw std::runtime_error("");
+        } catch (std::exception&) {}
+        REQUIRE(failed == 0);
+        REQUIRE(succeeded == 1);
+    }
+}
@@ -8,6 +8,14 @@
 
 #pragma once
 
+#include <exception>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FreeListPool.h"
 #include "NonCopyable.h"
 #include "NonMovable.h"
 
@@ -48,7 +56,69 @@ private:
     bool active_;
     Target target_;
 };
-    
+
+// Same as StackGuard, but the target only executes if the scope is exited because of an
+// exception. Typical use is to roll back partially applied changes :
+// void apply(Config& config) {
+//     config.beginUpdate();
+//     ScopeFail rollback([&]() noexcept { config.abortUpdate(); });
+//     // do stuff that may throw
+//     config.commitUpdate();
+// }
+// We compare std::uncaught_exceptions() at construction and destruction (instead of
+// std::uncaught_exception()) so that guards created inside destructors that run during
+// unwinding still behave correctly.
+// Since the target executes while an exception is in flight, it mustn't throw.
+// Unlike StackGuard this isn't free : the two std::uncaught_exceptions() calls make it larger
+// than a hand-written catch + rethrow (see Codegen/check_codegen.sh).
+template<typename Target>
+class ScopeFail : NonCopyable {
+public:
+    ScopeFail(Target&& target) : target_(std::move(target)), exceptions_(std::uncaught_exceptions()) {}
+
+    ~ScopeFail() {
+        static_assert(noexcept(target_()), "Target executes during unwinding, so it cannot throw");
+        if (std::uncaught_exceptions() > exceptions_) {
+            target_();
+        }
+    }
+
+    void dismiss() {
+        // No exception count can be greater than this, so we don't need a separate flag
+        exceptions_ = std::numeric_limits<int>::max();
+    }
+
+private:
+    Target target_;
+    int exceptions_;
+};
+
+// Same as StackGuard, but the target only executes if the scope is exited normally, ie. not
+// because of an exception. Like StackGuard, the target is allowed to throw.
+// Same cost as ScopeFail, the hand-written equivalent is a plain call after the scope's code.
+template<typename Target>
+class ScopeSuccess : NonCopyable {
+public:
+    ScopeSuccess(Target&& target) : target_(std::move(target)), exceptions_(std::uncaught_exceptions()) {}
+
+    ~ScopeSuccess() noexcept(false) {
+        static_assert(std::is_nothrow_destructible_v<Target>,
+                      "So that destr doesn't throw to prevent multiple exceptions in flight");
+        if (std::uncaught_exceptions() == exceptions_) {
+            target_();
+        }
+    }
+
+    void dismiss() {
+        // The exception count is never negative, so we don't need a separate flag
+        exceptions_ = -1;
+    }
+
+private:
+    Target target_;
+    int exceptions_;
+};
+
 // If we need the ability to use the guards as class members without knowing what
 // target they would be created with, we need to have some common base class. The
 // drawback of this is the introduction of vtables for every member that derives
@@ -59,7 +129,7 @@ public:
     virtual ~GuardBase() {};
     virtual void dismiss() = 0;
 };
-    
+
 template <typename T>
 constexpr size_t SizeInBytes() {
     using D = std::decay_t<T>;
@@ -70,6 +140,9 @@ constexpr size_t SizeInBytes() {
 // This saves binary size by avoiding multiple instantiations of the template for each target.
 // The requirement is that the target's operator() should be noexcept because that allows us
 // to destroy the type-erased target without leaks.
+// Heap instantiations (see makeGuard) are served from per-thread size-class free lists. Since
+// GuardBase has a virtual destructor, deleting through a GuardKey resolves to the class-specific
+// operator delete below, so GuardKey can stay a plain unique_ptr with the default deleter.
 template <size_t SizeInBytes, size_t Alignment>
 class Guard : public GuardBase, NonCopyable, NonMovable {
 public:
@@ -82,9 +155,11 @@ public:
         // std::fuction member variable which causes a large code bloat (due to vtables
         // and other template instantiations)
         // Also note how we remember D using the trampoline
-        trampoline_ = [](void * ptr) noexcept(true) {
+        trampoline_ = [](void * ptr, bool execute) noexcept(true) {
             auto& target = *static_cast<D*>(ptr);
-            target();
+            if (execute) {
+                target();
+            }
             target.~D();
         };
         static_assert(noexcept(t()), "Cannot create guard with a target that can throw");
@@ -92,23 +167,46 @@ public:
     
     ~Guard() {
         if (trampoline_) {
-            trampoline_(&storage_);
+            trampoline_(&storage_, true);
         }
     }
     
+    static void* operator new(std::size_t size) {
+        if constexpr (UsePool) {
+            static_assert(sizeof(Guard) <= Pool::Size);
+            return Pool::allocate();
+        } else {
+            return ::operator new(size, std::align_val_t{alignof(Guard)});
+        }
+    }
+
+    static void operator delete(void* ptr) noexcept {
+        if constexpr (UsePool) {
+            Pool::deallocate(ptr);
+        } else {
+            ::operator delete(ptr, std::align_val_t{alignof(Guard)});
+        }
+    }
+
     void dismiss() override final {
-        // This decision needs more thought. On one hand, we require an unnecessary if check in ~Guard.
-        // The other option is to say trampoline_ = [](void *) {}; // ie no-op
-        // In that case, a dismissed guard has to pay for a much more expensive function call to
-        // the trampoline. The reason we chose to use if in ~Guard is that if dismiss is
-        // uncommon, then the branch predictor would be accurate most of the time, otherwise
-        // dismiss is common and we save the cost of jumping to cold memory for dismissed guards.
-        trampoline_ = nullptr;
+        // Dismissing goes through the trampoline with execute = false, which destroys the target
+        // without running it. Only the trampoline knows the target's type, and destroying it
+        // right away means dismissing doesn't keep its captures alive until ~Guard. ~Guard
+        // still checks for a null trampoline, which is well predicted either way, so that
+        // a dismissed guard costs nothing more on destruction.
+        if (trampoline_) {
+            trampoline_(&storage_, false);
+            trampoline_ = nullptr;
+        }
     }
     
 private:
-    void(*trampoline_)(void *);
-    std::aligned_storage<SizeInBytes, Alignment> storage_;
+    void(*trampoline_)(void *, bool);
+    std::aligned_storage_t<SizeInBytes, Alignment> storage_;
+
+    using Pool = FreeListPool<detail::PoolSizeClass(sizeof(std::aligned_storage_t<SizeInBytes, Alignment>) +
+                                                    2 * sizeof(void*))>;
+    static constexpr bool UsePool = Pool::Size <= detail::MaxPooledGuardSize && Alignment <= Pool::Alignment;
 };
     
 template <typename T>
@@ -120,4 +218,268 @@ template <typename T>
 auto makeGuard(T&& target) {
     return GuardKey(new Guard(std::forward<T>(target)));
 }
+
+// Owning handle to a heap allocated guard target, which unlike GuardKey doesn't go through
+// GuardBase. The handle is two words, {trampoline, storage}, and the heap block only holds
+// the target itself (no vptr or trampoline). Executing the guard is a single indirect call
+// to the trampoline, which runs and destroys the target and returns the block to its pool.
+// Example :
+// struct Connection {
+//     GuardHandle closeGuard;
+// };
+// conn.closeGuard = makeGuardHandle([fd]() noexcept { ::close(fd); });
+// Keys created through makeGuard convert implicitly, so existing code can switch members over
+// without touching the call sites. Those keep their virtual dispatch though.
+class GuardHandle : NonCopyable {
+public:
+    constexpr GuardHandle() noexcept = default;
+    constexpr GuardHandle(std::nullptr_t) noexcept {}
+
+    GuardHandle(GuardKey key) noexcept : storage_(key.release()) {
+        if (storage_) {
+            trampoline_ = [](void* ptr, bool execute) noexcept(true) {
+                auto guard = static_cast<GuardBase*>(ptr);
+                if (!execute) {
+                    guard->dismiss();
+                }
+                delete guard;
+            };
+        }
+    }
+
+    GuardHandle(GuardHandle&& other) noexcept
+        : trampoline_(std::exchange(other.trampoline_, nullptr)),
+          storage_(std::exchange(other.storage_, nullptr)) {}
+
+    // The currently held target (if any) executes before taking over other's target, the same
+    // as assigning to a GuardKey.
+    GuardHandle& operator=(GuardHandle&& other) noexcept {
+        if (this != &other) {
+            run();
+            trampoline_ = std::exchange(other.trampoline_, nullptr);
+            storage_ = std::exchange(other.storage_, nullptr);
+        }
+        return *this;
+    }
+
+    GuardHandle& operator=(std::nullptr_t) noexcept {
+        run();
+        return *this;
+    }
+
+    ~GuardHandle() {
+        run();
+    }
+
+    // Destroys the target without executing it and frees its storage.
+    void dismiss() noexcept {
+        if (trampoline_) {
+            trampoline_(storage_, false);
+            trampoline_ = nullptr;
+            storage_ = nullptr;
+        }
+    }
+
+    // Address of the stored target, mostly useful for debugging and tests
+    void* get() const noexcept {
+        return storage_;
+    }
+
+    explicit operator bool() const noexcept {
+        return trampoline_ != nullptr;
+    }
+
+private:
+    template <typename T>
+    friend GuardHandle makeGuardHandle(T&& target);
+
+    // Same pooling policy as Guard, but the blocks are sized for the bare target
+    template <typename D>
+    struct Storage {
+        using Pool = FreeListPool<detail::PoolSizeClass(sizeof(D))>;
+        static constexpr bool UsePool = Pool::Size <= detail::MaxPooledGuardSize &&
+                                        alignof(D) <= Pool::Alignment;
+
+        static void* allocate() {
+            if constexpr (UsePool) {
+                return Pool::allocate();
+            } else {
+                return ::operator new(sizeof(D), std::align_val_t{alignof(D)});
+            }
+        }
+
+        static void deallocate(void* ptr) noexcept {
+            if constexpr (UsePool) {
+                Pool::deallocate(ptr);
+            } else {
+                ::operator delete(ptr, std::align_val_t{alignof(D)});
+            }
+        }
+    };
+
+    template <typename Target>
+    void emplace(Target&& t) {
+        using D = std::decay_t<Target>;
+        static_assert(noexcept(t()), "Cannot create guard with a target that can throw");
+        auto storage = Storage<D>::allocate();
+        if constexpr (std::is_nothrow_constructible_v<D, Target>) {
+            new (storage) D(std::forward<Target>(t));
+        } else {
+            try {
+                new (storage) D(std::forward<Target>(t));
+            } catch (...) {
+                Storage<D>::deallocate(storage);
+                throw;
+            }
+        }
+        storage_ = storage;
+        trampoline_ = [](void* ptr, bool execute) noexcept(true) {
+            auto& target = *static_cast<D*>(ptr);
+            if (execute) {
+                target();
+            }
+            target.~D();
+            Storage<D>::deallocate(ptr);
+        };
+    }
+
+    void run() noexcept {
+        if (trampoline_) {
+            trampoline_(storage_, true);
+            trampoline_ = nullptr;
+            storage_ = nullptr;
+        }
+    }
+
+    void(*trampoline_)(void*, bool) = nullptr;
+    void* storage_ = nullptr;
+};
+
+// Same as makeGuard, but returns a GuardHandle
+template <typename T>
+GuardHandle makeGuardHandle(T&& target) {
+    static_assert(!std::is_lvalue_reference_v<T>, "The guard takes ownership of the target");
+    GuardHandle handle;
+    handle.emplace(std::forward<T>(target));
+    return handle;
+}
+
+// A fixed size guard which can be used as a class member without the heap allocation, vtable
+// and virtual calls that come with GuardKey. Any noexcept target up to BufferBytes is stored
+// inline, and like Guard, the target type is only remembered through a capture-less trampoline.
+// Example :
+// struct Connection {
+//     InplaceGuard<16> closeGuard;
+// };
+// conn.closeGuard = InplaceGuard<16>([fd]() noexcept { ::close(fd); });
+// Targets must be nothrow move constructible so that the guard itself can be moved around.
+// Moving a guard transfers the pending target, the moved-from guard becomes empty.
+template <size_t BufferBytes, size_t Alignment = alignof(void*)>
+class InplaceGuard : NonCopyable {
+public:
+    constexpr InplaceGuard() noexcept = default;
+
+    template <typename Target,
+              typename = std::enable_if_t<!std::is_lvalue_reference_v<Target> &&
+                                          !std::is_same_v<std::decay_t<Target>, InplaceGuard>>>
+    InplaceGuard(Target&& t) noexcept(std::is_nothrow_constructible_v<std::decay_t<Target>, Target>) {
+        emplace(std::forward<Target>(t));
+    }
+
+    InplaceGuard(InplaceGuard&& other) noexcept {
+        takeFrom(other);
+    }
+
+    // The currently held target (if any) executes before taking over other's target, the same
+    // as if *this had gone out of scope.
+    InplaceGuard& operator=(InplaceGuard&& other) noexcept {
+        if (this != &other) {
+            run();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~InplaceGuard() {
+        run();
+    }
+
+    // Unlike Guard, the target is destroyed right away (without being called), so dismissing
+    // doesn't keep any of the captured state alive.
+    void dismiss() noexcept {
+        if (trampoline_) {
+            trampoline_(Op::Destroy, &storage_, nullptr);
+            trampoline_ = nullptr;
+        }
+    }
+
+    // Executes the currently held target (if any) and then starts guarding newTarget.
+    template <typename Target, typename = std::enable_if_t<!std::is_lvalue_reference_v<Target>>>
+    void reset(Target&& newTarget) noexcept(std::is_nothrow_constructible_v<std::decay_t<Target>, Target>) {
+        run();
+        emplace(std::forward<Target>(newTarget));
+    }
+
+    // Executes the currently held target (if any) and leaves the guard empty.
+    void reset() noexcept {
+        run();
+    }
+
+    explicit operator bool() const noexcept {
+        return trampoline_ != nullptr;
+    }
+
+private:
+    enum class Op {
+        Run,
+        Destroy,
+        Move,
+    };
+
+    template <typename Target>
+    void emplace(Target&& t) {
+        using D = std::decay_t<Target>;
+        static_assert(sizeof(D) <= BufferBytes, "Target doesn't fit in the inline buffer");
+        static_assert(alignof(D) <= Alignment, "Target is over-aligned for the inline buffer");
+        static_assert(noexcept(t()), "Cannot create guard with a target that can throw");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "Target must be nothrow movable");
+        new (&storage_) D(std::forward<Target>(t));
+        // A single trampoline handles every operation so that the guard only carries one
+        // pointer on top of the buffer.
+        trampoline_ = [](Op op, void* ptr, void* dest) noexcept(true) {
+            auto& target = *static_cast<D*>(ptr);
+            switch (op) {
+                case Op::Run:
+                    target();
+                    target.~D();
+                    break;
+                case Op::Destroy:
+                    target.~D();
+                    break;
+                case Op::Move:
+                    new (dest) D(std::move(target));
+                    target.~D();
+                    break;
+            }
+        };
+    }
+
+    void run() noexcept {
+        if (trampoline_) {
+            trampoline_(Op::Run, &storage_, nullptr);
+            trampoline_ = nullptr;
+        }
+    }
+
+    void takeFrom(InplaceGuard& other) noexcept {
+        if (other.trampoline_) {
+            other.trampoline_(Op::Move, &other.storage_, &storage_);
+            trampoline_ = other.trampoline_;
+            other.trampoline_ = nullptr;
+        }
+    }
+
+    void(*trampoline_)(Op, void*, void*) = nullptr;
+    std::aligned_storage_t<BufferBytes, Alignment> storage_;
+};
 }
@@ -0,0 +1,112 @@
+//
+//  HazardPointer.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "HazardPointer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Tracked {
+    static inline std::atomic<int> alive{0};
+    Tracked(int v = 0) : value(v) { alive++; }
+    ~Tracked() { alive--; }
+    int value;
+};
+}
+
+TEST_CASE("[HazardDomain] unprotected objects are freed on scan") {
+    {
+        sh::HazardDomain domain;
+        for (int i = 0; i < 1000; i++) {
+            domain.retire(new Tracked(i));
+        }
+        REQUIRE(Tracked::alive < static_cast<int>(sh::HazardDomain::ScanThreshold));
+        domain.collect();
+        REQUIRE(Tracked::alive == 0);
+    }
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[HazardDomain] protected objects survive until the guard is gone") {
+    sh::HazardDomain domain;
+    std::atomic<Tracked*> head{new Tracked(1)};
+    {
+        sh::HazardGuard guard(domain);
+        auto ptr = guard.protect(head);
+        REQUIRE(ptr->value == 1);
+        
+        domain.retire(head.exchange(nullptr));
+        domain.retire(new Tracked(2));
+        domain.collect();
+        // Only the protected object is kept alive, unlike an epoch which would keep both
+        REQUIRE(Tracked::alive == 1);
+        REQUIRE(ptr->value == 1);
+    }
+    domain.collect();
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[HazardDomain] reset stops protecting") {
+    sh::HazardDomain domain;
+    std::atomic<Tracked*> head{new Tracked(1)};
+    sh::HazardGuard guard(domain);
+    guard.protect(head);
+    domain.retire(head.exchange(nullptr));
+    domain.collect();
+    REQUIRE(Tracked::alive == 1);
+    guard.reset();
+    domain.collect();
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("[HazardDomain] running out of slots throws") {
+    sh::HazardDomain domain;
+    std::vector<std::unique_ptr<sh::HazardGuard>> guards;
+    for (std::size_t i = 0; i < sh::HazardDomain::SlotsPerThread; i++) {
+        guards.push_back(std::make_unique<sh::HazardGuard>(domain));
+    }
+    REQUIRE_THROWS_AS(sh::HazardGuard(domain), std::runtime_error);
+    // Slots are reusable once released
+    guards.pop_back();
+    sh::HazardGuard guard(domain);
+}
+
+TEST_CASE("[HazardDomain] concurrent readers and writers") {
+    struct Node {
+        int value;
+    };
+    sh::HazardDomain domain;
+    std::atomic<Node*> head{new Node{0}};
+    std::atomic<bool> done{false};
+    std::atomic<bool> corrupted{false};
+    
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                sh::HazardGuard guard(domain);
+                if (guard.protect(head)->value < 0) {
+                    corrupted = true;
+                }
+            }
+        });
+    }
+    for (int i = 1; i < 5000; i++) {
+        domain.retire(head.exchange(new Node{i}, std::memory_order_acq_rel));
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    delete head.load();
+    REQUIRE(!corrupted);
+}
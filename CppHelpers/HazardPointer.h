@@ -0,0 +1,203 @@
+//
+//  HazardPointer.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "ArrayVector.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "ThreadRecords.h"
+
+namespace sh {
+// Hazard pointer based memory reclamation domain. Unlike Epoch, a slow reader only keeps
+// alive the objects it has explicitly protected rather than everything retired after it
+// pinned, at the cost of a store and a re-check for every protected pointer.
+// The API mirrors Epoch so code can switch between the two schemes :
+// HazardDomain domain;
+// int read(std::atomic<Node*>& head) {
+//     HazardGuard guard(domain);
+//     return guard.protect(head)->value;
+// }
+// void update(std::atomic<Node*>& head, Node* node) {
+//     auto old = head.exchange(node);
+//     domain.retire(old);
+// }
+// Every thread owns SlotsPerThread hazard slots, ie. at most that many HazardGuards can be
+// alive on a thread at once. Retired objects are buffered per thread and scanned in batches:
+// the hazards of all threads are snapshotted and sorted once per scan, so every retired
+// object is checked with a binary search.
+class HazardDomain : NonCopyable, NonMovable {
+public:
+    static constexpr std::size_t MaxThreads = 128;
+    static constexpr std::size_t SlotsPerThread = 4;
+    static constexpr std::size_t RetiredCapacity = 128;
+    // Scanning costs O(hazards), so we only scan once there are enough retired objects to
+    // amortize that.
+    static constexpr std::size_t ScanThreshold = 64;
+
+    HazardDomain() = default;
+
+    // No thread may hold a HazardGuard when the domain is destroyed.
+    ~HazardDomain() {
+        const auto count = records_.count();
+        for (std::size_t i = 0; i < count; i++) {
+            auto& record = records_[i];
+            assert(record.used == 0);
+            for (auto& retired : record.retired) {
+                retired.deleter(retired.ptr);
+            }
+            for (auto& retired : record.overflow) {
+                retired.deleter(retired.ptr);
+            }
+        }
+    }
+
+    // Hands ptr over to the domain, deleter(ptr) is called once no hazard points to it.
+    // ptr must already be unreachable for new readers.
+    void retire(void* ptr, void(*deleter)(void*)) {
+        auto& record = records_.local();
+        if (record.retired.size() < record.retired.capacity()) {
+            record.retired.push_back({ptr, deleter});
+        } else {
+            record.overflow.push_back({ptr, deleter});
+        }
+        if (record.retired.size() + record.overflow.size() >= ScanThreshold) {
+            scan(record);
+        }
+    }
+
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // Frees whatever the calling thread has retired that isn't protected. This happens
+    // automatically as part of retire().
+    void collect() {
+        scan(records_.local());
+    }
+
+private:
+    friend class HazardGuard;
+
+    struct Retired {
+        void* ptr;
+        void(*deleter)(void*);
+    };
+
+    struct alignas(64) Record {
+        std::atomic<void*> hazards[SlotsPerThread] = {};
+        // Bitmask of slots in use, only ever touched by the owning thread
+        std::uint32_t used = 0;
+        ArrayVector<Retired, RetiredCapacity> retired;
+        std::vector<Retired> overflow;
+    };
+    static_assert(SlotsPerThread <= 32);
+
+    std::atomic<void*>& acquireSlot(Record& record) {
+        for (std::size_t i = 0; i < SlotsPerThread; i++) {
+            if (!(record.used & (1u << i))) {
+                record.used |= (1u << i);
+                return record.hazards[i];
+            }
+        }
+        throw std::runtime_error("Out of hazard slots");
+    }
+
+    void releaseSlot(Record& record, std::atomic<void*>& slot) noexcept {
+        slot.store(nullptr, std::memory_order_release);
+        record.used &= ~(1u << (&slot - record.hazards));
+    }
+
+    void scan(Record& record) {
+        // Pairs with the fence in protect(), a reader has either published its hazard before
+        // we take the snapshot, or it will see that the object was unlinked when re-checking.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ArrayVector<void*, MaxThreads * SlotsPerThread> hazards;
+        const auto count = records_.count();
+        for (std::size_t i = 0; i < count; i++) {
+            for (auto& slot : records_[i].hazards) {
+                if (auto ptr = slot.load(std::memory_order_acquire)) {
+                    hazards.push_back(ptr);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto isProtected = [&](const Retired& retired) {
+            return std::binary_search(hazards.begin(), hazards.end(), retired.ptr);
+        };
+        auto reclaim = [&](auto& list) {
+            auto end = std::partition(list.begin(), list.end(), isProtected);
+            for (auto it = end; it != list.end(); ++it) {
+                it->deleter(it->ptr);
+            }
+            list.erase(end, list.end());
+        };
+        reclaim(record.retired);
+        reclaim(record.overflow);
+        // Whatever is still protected moves back inline if there is room
+        while (!record.overflow.empty() && record.retired.size() < record.retired.capacity()) {
+            record.retired.push_back(record.overflow.back());
+            record.overflow.pop_back();
+        }
+    }
+
+    detail::ThreadRecords<Record, MaxThreads> records_;
+};
+
+// Owns one hazard slot of the calling thread for the lifetime of the guard. Whatever pointer
+// is protected through the guard won't be freed by the domain until the guard protects
+// something else or goes out of scope.
+// Like StackGuard, this is meant for scope-based usage.
+class HazardGuard : NonCopyable, NonMovable {
+public:
+    explicit HazardGuard(HazardDomain& domain)
+        : record_(domain.records_.local()), slot_(domain.acquireSlot(record_)), domain_(domain) {}
+
+    ~HazardGuard() {
+        domain_.releaseSlot(record_, slot_);
+    }
+
+    // Loads src and protects the loaded pointer. The returned pointer stays valid until the
+    // guard is destroyed, reset or used to protect something else.
+    template <typename T>
+    T* protect(const std::atomic<T*>& src) noexcept {
+        auto ptr = src.load(std::memory_order_relaxed);
+        while (true) {
+            slot_.store(ptr, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // If src still points to the same object, it wasn't retired before we published
+            // the hazard, so any scan from now on will see it.
+            auto current = src.load(std::memory_order_acquire);
+            if (current == ptr) {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    // Stops protecting the current pointer
+    void reset() noexcept {
+        slot_.store(nullptr, std::memory_order_release);
+    }
+
+private:
+    HazardDomain::Record& record_;
+    std::atomic<void*>& slot_;
+    HazardDomain& domain_;
+};
+}
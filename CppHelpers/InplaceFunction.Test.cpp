@@ -0,0 +1,149 @@
+//
+//  InplaceFunction.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "InplaceFunction.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+struct Counter {
+    static inline int alive = 0;
+    Counter() { alive++; }
+    Counter(const Counter&) { alive++; }
+    Counter(Counter&&) noexcept { alive++; }
+    ~Counter() { alive--; }
+    int operator()(int x) const { return x + 1; }
+};
+
+int twice(int x) {
+    return 2 * x;
+}
+}
+
+TEST_CASE("[InplaceFunction] static asserts") {
+    using Function = sh::InplaceFunction<int(int)>;
+    static_assert(sizeof(Function) == 6 * sizeof(void*));
+    static_assert(std::is_nothrow_move_constructible_v<Function>);
+    static_assert(std::is_copy_constructible_v<Function>);
+    static_assert(std::is_constructible_v<Function, decltype(&twice)>);
+    static_assert(!std::is_constructible_v<Function, std::string>);
+    static_assert(!std::is_constructible_v<sh::InplaceFunction<void(std::string)>, decltype(&twice)>);
+}
+
+TEST_CASE("[InplaceFunction] invokes targets") {
+    SECTION("Function pointers and lambdas") {
+        sh::InplaceFunction<int(int)> function = &twice;
+        REQUIRE(function(4) == 8);
+        int offset = 10;
+        function = [&offset](int x) { return x + offset; };
+        REQUIRE(function(4) == 14);
+    }
+
+    SECTION("Arguments are forwarded") {
+        sh::InplaceFunction<std::string(std::string&, std::unique_ptr<int>)> function =
+            [](std::string& str, std::unique_ptr<int> ptr) {
+                str += std::to_string(*ptr);
+                return str;
+            };
+        std::string str = "a";
+        REQUIRE(function(str, std::make_unique<int>(1)) == "a1");
+        REQUIRE(str == "a1");
+    }
+
+    SECTION("Empty functions throw") {
+        sh::InplaceFunction<void()> function;
+        REQUIRE_FALSE(function);
+        REQUIRE_THROWS_AS(function(), std::bad_function_call);
+        function = []() {};
+        REQUIRE(function);
+        function = nullptr;
+        REQUIRE_FALSE(function);
+    }
+
+    SECTION("Null function pointers give empty functions") {
+        sh::InplaceFunction<int(int)> function = static_cast<int (*)(int)>(nullptr);
+        REQUIRE_FALSE(function);
+        REQUIRE_THROWS_AS(function(1), std::bad_function_call);
+        function = &twice;
+        REQUIRE(function);
+
+        sh::InplaceFunction<int(const Counter&, int)> member = &Counter::operator();
+        REQUIRE(member);
+        member = static_cast<int (Counter::*)(int) const>(nullptr);
+        REQUIRE_FALSE(member);
+    }
+
+    SECTION("Void signatures discard the result") {
+        int calls = 0;
+        sh::InplaceFunction<void(int)> function = [&calls](int x) {
+            calls += x;
+            return calls;
+        };
+        function(2);
+        REQUIRE(calls == 2);
+        function = &twice;
+        function(3);
+    }
+
+    SECTION("Targets fill the whole buffer") {
+        std::array<char, 32> data{};
+        data[31] = 'x';
+        sh::InplaceFunction<char()> function = [data]() { return data[31]; };
+        REQUIRE(function() == 'x');
+    }
+}
+
+TEST_CASE("[InplaceFunction] copy and move") {
+    Counter::alive = 0;
+
+    SECTION("Non-trivial targets are managed") {
+        {
+            sh::InplaceFunction<int(int)> first = Counter{};
+            REQUIRE(Counter::alive == 1);
+            auto second = first;
+            REQUIRE(Counter::alive == 2);
+            auto third = std::move(first);
+            REQUIRE(Counter::alive == 2);
+            REQUIRE_FALSE(first);
+            REQUIRE(second(1) == 2);
+            REQUIRE(third(2) == 3);
+            second = nullptr;
+            REQUIRE(Counter::alive == 1);
+        }
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Captured state is copied") {
+        auto shared = std::make_shared<int>(5);
+        sh::InplaceFunction<int()> first = [shared]() { return *shared; };
+        REQUIRE(shared.use_count() == 2);
+        {
+            auto second = first;
+            REQUIRE(shared.use_count() == 3);
+            REQUIRE(second() == 5);
+        }
+        REQUIRE(shared.use_count() == 2);
+        first = nullptr;
+        REQUIRE(shared.use_count() == 1);
+    }
+
+    SECTION("Trivial targets are relocated") {
+        int value = 3;
+        sh::InplaceFunction<int()> first = [&value]() { return value; };
+        auto second = first;
+        auto third = std::move(first);
+        value = 4;
+        REQUIRE(second() == 4);
+        REQUIRE(third() == 4);
+    }
+}
@@ -0,0 +1,196 @@
+//
+//  InplaceFunction.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Relocatable.h"
+
+namespace sh {
+template <typename Signature, std::size_t Bytes = 4 * sizeof(void*), std::size_t Alignment = alignof(void*)>
+class InplaceFunction;
+
+// Drop-in for std::function which never allocates : the target is always stored inline, and
+// targets that don't fit in Bytes (or Alignment) fail to compile instead of falling back to
+// the heap.
+// Like Guard, the target type is only remembered through capture-less trampolines, one that
+// invokes the target and one that copies, moves and destroys it. Calling is a single indirect
+// call through the invoker, an empty function's invoker throws std::bad_function_call so the
+// call path doesn't need a branch.
+// Targets which are trivially copyable (eg. lambdas capturing pointers, references and
+// integers) are copied and moved with a memcpy of their own bytes (see RelocateTrivially), and
+// destroying them is a no-op.
+// Example :
+// struct Button {
+//     InplaceFunction<void(int)> onClick;
+// };
+// button.onClick = [this](int x) { handleClick(x); };
+template <typename R, typename... Args, std::size_t Bytes, std::size_t Alignment>
+class InplaceFunction<R(Args...), Bytes, Alignment> {
+public:
+    InplaceFunction() noexcept = default;
+
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template <typename Target,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Target>, InplaceFunction> &&
+                                          std::is_invocable_r_v<R, std::decay_t<Target>&, Args...>>>
+    InplaceFunction(Target&& t) noexcept(std::is_nothrow_constructible_v<std::decay_t<Target>, Target>) {
+        emplace(std::forward<Target>(t));
+    }
+
+    InplaceFunction(const InplaceFunction& other) {
+        copyFrom(other);
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept {
+        moveFrom(other);
+    }
+
+    // Exception safety: if copying the target throws, *this is left empty
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename Target,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Target>, InplaceFunction> &&
+                                          std::is_invocable_r_v<R, std::decay_t<Target>&, Args...>>>
+    InplaceFunction& operator=(Target&& t) {
+        reset();
+        emplace(std::forward<Target>(t));
+        return *this;
+    }
+
+    ~InplaceFunction() {
+        reset();
+    }
+
+    R operator()(Args... args) const {
+        return invoker_(const_cast<void*>(static_cast<const void*>(&storage_)), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return invoker_ != &emptyInvoker;
+    }
+
+private:
+    enum class Op {
+        Copy,
+        Move,
+        Destroy,
+    };
+
+    using Invoker = R(*)(void*, Args&&...);
+    using Manager = void(*)(Op, void* from, void* to);
+
+    [[noreturn]] static R emptyInvoker(void*, Args&&...) {
+        throw std::bad_function_call();
+    }
+
+    template <typename Target>
+    void emplace(Target&& t) {
+        using D = std::decay_t<Target>;
+        static_assert(sizeof(D) <= Bytes, "Target doesn't fit in the inline buffer");
+        static_assert(alignof(D) <= Alignment, "Target is over-aligned for the inline buffer");
+        static_assert(std::is_copy_constructible_v<D>, "Targets must be copyable, like std::function");
+        static_assert(std::is_nothrow_move_constructible_v<D>, "Targets must be nothrow movable");
+        if constexpr (std::is_pointer_v<D> || std::is_member_pointer_v<D>) {
+            // Like std::function, a null function or member pointer gives an empty function
+            if (t == nullptr) {
+                return;
+            }
+        }
+        new (&storage_) D(std::forward<Target>(t));
+        invoker_ = [](void* ptr, Args&&... args) -> R {
+            // Void signatures accept targets which return something, the result is discarded
+            if constexpr (std::is_void_v<R>) {
+                std::invoke(*static_cast<D*>(ptr), std::forward<Args>(args)...);
+            } else {
+                return std::invoke(*static_cast<D*>(ptr), std::forward<Args>(args)...);
+            }
+        };
+        if constexpr (std::is_trivially_copyable_v<D>) {
+            // Copying leaves the source intact, which for these is the same memcpy as moving
+            manager_ = [](Op op, void* from, void* to) {
+                if (op != Op::Destroy) {
+                    RelocateTrivially<D>(from, to);
+                }
+            };
+        } else {
+            manager_ = [](Op op, void* from, void* to) {
+                auto& target = *static_cast<D*>(from);
+                switch (op) {
+                    case Op::Copy:
+                        new (to) D(target);
+                        break;
+                    case Op::Move:
+                        new (to) D(std::move(target));
+                        target.~D();
+                        break;
+                    case Op::Destroy:
+                        target.~D();
+                        break;
+                }
+            };
+        }
+    }
+
+    void reset() noexcept {
+        if (manager_) {
+            manager_(Op::Destroy, &storage_, nullptr);
+            manager_ = nullptr;
+        }
+        invoker_ = &emptyInvoker;
+    }
+
+    void copyFrom(const InplaceFunction& other) {
+        // The storage of an empty function is uninitialized
+        if (!other) {
+            return;
+        }
+        other.manager_(Op::Copy, const_cast<void*>(static_cast<const void*>(&other.storage_)), &storage_);
+        invoker_ = other.invoker_;
+        manager_ = other.manager_;
+    }
+
+    void moveFrom(InplaceFunction& other) noexcept {
+        if (!other) {
+            return;
+        }
+        other.manager_(Op::Move, &other.storage_, &storage_);
+        invoker_ = std::exchange(other.invoker_, &emptyInvoker);
+        manager_ = std::exchange(other.manager_, nullptr);
+    }
+
+    Invoker invoker_ = &emptyInvoker;
+    Manager manager_ = nullptr;
+    std::aligned_storage_t<Bytes, Alignment> storage_;
+};
+}
@@ -0,0 +1,86 @@
+//
+//  MoveOnlyFunction.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "MoveOnlyFunction.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("Move-only function vs std::function", "[!benchmark][MoveOnlyFunction]") {
+    // std::function needs copyable targets, so a unique_ptr capture has to be boxed in a
+    // shared_ptr, which is the usual workaround.
+    BENCHMARK("MoveOnlyFunction construct, unique_ptr capture") {
+        sh::MoveOnlyFunction<int()> f = [value = std::make_unique<int>(1)]() { return *value; };
+        return f();
+    };
+
+    BENCHMARK("std::function construct, shared_ptr boxed unique_ptr") {
+        auto boxed = std::make_shared<std::unique_ptr<int>>(std::make_unique<int>(1));
+        std::function<int()> f = [boxed]() { return **boxed; };
+        return f();
+    };
+
+    // Larger than the inline buffer of both
+    std::array<int, 12> values{};
+    values[11] = 1;
+
+    BENCHMARK("MoveOnlyFunction construct, heap target") {
+        sh::MoveOnlyFunction<int()> f = [values]() { return values[11]; };
+        return f();
+    };
+
+    BENCHMARK("MoveOnlyFunction construct, pooled heap target") {
+        sh::MoveOnlyFunction<int(), 4 * sizeof(void*), sh::PooledFunctionAllocator> f = [values]() {
+            return values[11];
+        };
+        return f();
+    };
+
+    BENCHMARK("std::function construct, heap target") {
+        std::function<int()> f = [values]() { return values[11]; };
+        return f();
+    };
+
+    BENCHMARK_ADVANCED("MoveOnlyFunction move")(Catch::Benchmark::Chronometer meter) {
+        sh::MoveOnlyFunction<int()> first = [value = std::make_unique<int>(1)]() { return *value; };
+        sh::MoveOnlyFunction<int()> second;
+        meter.measure([&]() {
+            second = std::move(first);
+            first = std::move(second);
+            return first();
+        });
+    };
+
+    BENCHMARK_ADVANCED("std::function move")(Catch::Benchmark::Chronometer meter) {
+        auto boxed = std::make_shared<std::unique_ptr<int>>(std::make_unique<int>(1));
+        std::function<int()> first = [boxed]() { return **boxed; };
+        std::function<int()> second;
+        meter.measure([&]() {
+            second = std::move(first);
+            first = std::move(second);
+            return first();
+        });
+    };
+
+    int counter = 0;
+    sh::MoveOnlyFunction<int(int) noexcept> moveOnly = [&counter](int x) noexcept { return counter += x; };
+    std::function<int(int)> function = [&counter](int x) { return counter += x; };
+
+    BENCHMARK("MoveOnlyFunction invoke") {
+        return moveOnly(1);
+    };
+
+    BENCHMARK("std::function invoke") {
+        return function(1);
+    };
+}
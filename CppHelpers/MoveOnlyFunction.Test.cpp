@@ -0,0 +1,144 @@
+//
+//  MoveOnlyFunction.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "MoveOnlyFunction.h"
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+namespace {
+struct Counter {
+    static inline int alive = 0;
+    Counter() { alive++; }
+    Counter(Counter&&) noexcept { alive++; }
+    ~Counter() { alive--; }
+};
+
+int addOne(int x) noexcept {
+    return x + 1;
+}
+}
+
+TEST_CASE("[MoveOnlyFunction] static asserts") {
+    using Function = sh::MoveOnlyFunction<int(int)>;
+    using ConstFunction = sh::MoveOnlyFunction<int(int) const>;
+    using NoexceptFunction = sh::MoveOnlyFunction<int(int) noexcept>;
+    auto mutableLambda = [x = 0](int) mutable { return ++x; };
+    auto throwingLambda = [](int x) { return x; };
+    static_assert(!std::is_copy_constructible_v<Function>);
+    static_assert(std::is_nothrow_move_constructible_v<Function>);
+    static_assert(std::is_constructible_v<Function, decltype(mutableLambda)>);
+    static_assert(!std::is_constructible_v<ConstFunction, decltype(mutableLambda)>);
+    static_assert(!std::is_constructible_v<NoexceptFunction, decltype(throwingLambda)>);
+    static_assert(std::is_nothrow_invocable_v<NoexceptFunction&, int>);
+    static_assert(!std::is_invocable_v<const Function&, int>);
+    static_assert(std::is_invocable_v<const ConstFunction&, int>);
+    static_assert(Function::StoredInline<std::unique_ptr<int>>);
+    static_assert(!Function::StoredInline<std::array<char, 64>>);
+}
+
+TEST_CASE("[MoveOnlyFunction] invokes targets") {
+    SECTION("Move-only captures") {
+        sh::MoveOnlyFunction<int()> f = [value = std::make_unique<int>(5)]() { return *value; };
+        REQUIRE(f);
+        REQUIRE(f() == 5);
+    }
+
+    SECTION("Mutable targets") {
+        sh::MoveOnlyFunction<int()> f = [x = 0]() mutable { return ++x; };
+        f();
+        REQUIRE(f() == 2);
+    }
+
+    SECTION("Const and noexcept signatures") {
+        const sh::MoveOnlyFunction<int(int) const noexcept> f = &addOne;
+        REQUIRE(f(1) == 2);
+        sh::MoveOnlyFunction<int(int) noexcept> g = [](int x) noexcept { return x * 2; };
+        REQUIRE(g(2) == 4);
+    }
+
+    SECTION("Heap targets") {
+        std::array<int, 16> values{};
+        values[15] = 7;
+        sh::MoveOnlyFunction<int()> f = [values, owned = std::make_unique<int>(1)]() { return values[15] + *owned; };
+        REQUIRE(f() == 8);
+    }
+
+    SECTION("Pooled heap targets") {
+        std::array<int, 16> values{};
+        values[0] = 3;
+        sh::MoveOnlyFunction<int(), 16, sh::PooledFunctionAllocator> f = [values]() { return values[0]; };
+        REQUIRE(f() == 3);
+        auto g = std::move(f);
+        REQUIRE_FALSE(f);
+        REQUIRE(g() == 3);
+    }
+
+    SECTION("Empty functions throw") {
+        sh::MoveOnlyFunction<void()> f;
+        REQUIRE_FALSE(f);
+        REQUIRE_THROWS_AS(f(), std::bad_function_call);
+        f = [] {};
+        REQUIRE_NOTHROW(f());
+        f = nullptr;
+        REQUIRE_THROWS_AS(f(), std::bad_function_call);
+    }
+
+    SECTION("Null function pointers give empty functions") {
+        sh::MoveOnlyFunction<int(int)> f = static_cast<int (*)(int) noexcept>(nullptr);
+        REQUIRE_FALSE(f);
+        REQUIRE_THROWS_AS(f(1), std::bad_function_call);
+        f = &addOne;
+        REQUIRE(f(1) == 2);
+    }
+
+    SECTION("Void signatures discard the result") {
+        int calls = 0;
+        sh::MoveOnlyFunction<void(int)> f = [&calls](int x) { return calls += x; };
+        f(2);
+        REQUIRE(calls == 2);
+        std::array<int, 16> values{};
+        values[0] = 3;
+        sh::MoveOnlyFunction<void() const noexcept> heap = [&calls, values]() noexcept { return calls += values[0]; };
+        heap();
+        REQUIRE(calls == 5);
+    }
+}
+
+TEST_CASE("[MoveOnlyFunction] move and destroy") {
+    Counter::alive = 0;
+
+    SECTION("Inline targets") {
+        {
+            sh::MoveOnlyFunction<void()> f = [counter = Counter{}]() {};
+            REQUIRE(Counter::alive == 1);
+            auto g = std::move(f);
+            REQUIRE_FALSE(f);
+            REQUIRE(g);
+            REQUIRE(Counter::alive == 1);
+        }
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Heap targets are moved by pointer") {
+        {
+            std::array<char, 64> padding{};
+            sh::MoveOnlyFunction<void()> f = [counter = Counter{}, padding]() {};
+            sh::MoveOnlyFunction<void()> g;
+            g = std::move(f);
+            REQUIRE(Counter::alive == 1);
+            g = nullptr;
+            REQUIRE(Counter::alive == 0);
+            g = [counter = Counter{}, padding]() {};
+        }
+        REQUIRE(Counter::alive == 0);
+    }
+}
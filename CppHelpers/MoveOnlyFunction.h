@@ -0,0 +1,284 @@
+//
+//  MoveOnlyFunction.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "FreeListPool.h"
+#include "Relocatable.h"
+
+namespace sh {
+// Allocators decide where MoveOnlyFunction puts targets which don't fit in the inline buffer.
+// The target type is known at compile time, so they can pick a size class up front.
+struct DefaultFunctionAllocator {
+    template <typename T>
+    static void* allocate() {
+        return ::operator new(sizeof(T), std::align_val_t{alignof(T)});
+    }
+
+    template <typename T>
+    static void deallocate(void* ptr) noexcept {
+        ::operator delete(ptr, std::align_val_t{alignof(T)});
+    }
+};
+
+// Serves targets from the per-thread free lists that back makeGuard (see FreeListPool), large
+// or over-aligned targets go to the global allocator.
+struct PooledFunctionAllocator {
+    template <typename T>
+    static void* allocate() {
+        if constexpr (UsePool<T>) {
+            return Pool<T>::allocate();
+        } else {
+            return DefaultFunctionAllocator::allocate<T>();
+        }
+    }
+
+    template <typename T>
+    static void deallocate(void* ptr) noexcept {
+        if constexpr (UsePool<T>) {
+            Pool<T>::deallocate(ptr);
+        } else {
+            DefaultFunctionAllocator::deallocate<T>(ptr);
+        }
+    }
+
+private:
+    template <typename T>
+    using Pool = FreeListPool<detail::PoolSizeClass(sizeof(T))>;
+
+    template <typename T>
+    static constexpr bool UsePool = Pool<T>::Size <= detail::MaxPooledGuardSize && alignof(T) <= Pool<T>::Alignment;
+};
+
+namespace detail {
+// Everything but operator(), which is provided by the MoveOnlyFunction specializations since
+// its qualifiers depend on the signature.
+template <std::size_t InlineBytes, typename Allocator, bool Const, bool Noexcept, typename R, typename... Args>
+class MoveOnlyFunctionBase {
+public:
+    static_assert(InlineBytes >= sizeof(void*), "The buffer must be able to hold a pointer");
+
+    // Targets are invoked as const for const signatures
+    template <typename D>
+    using Callee = std::conditional_t<Const, const D&, D&>;
+
+    template <typename D>
+    static constexpr bool IsInvocable = Noexcept ? std::is_nothrow_invocable_r_v<R, Callee<D>, Args...>
+                                                 : std::is_invocable_r_v<R, Callee<D>, Args...>;
+
+    // Targets which are stored in the inline buffer, anything else goes through Allocator
+    template <typename D>
+    static constexpr bool StoredInline = sizeof(D) <= InlineBytes && alignof(D) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<D>;
+
+    MoveOnlyFunctionBase() noexcept = default;
+
+    MoveOnlyFunctionBase(std::nullptr_t) noexcept {}
+
+    template <typename Target,
+              typename = std::enable_if_t<!std::is_base_of_v<MoveOnlyFunctionBase, std::decay_t<Target>> &&
+                                          IsInvocable<std::decay_t<Target>>>>
+    MoveOnlyFunctionBase(Target&& t) {
+        emplace(std::forward<Target>(t));
+    }
+
+    MoveOnlyFunctionBase(MoveOnlyFunctionBase&& other) noexcept {
+        moveFrom(other);
+    }
+
+    MoveOnlyFunctionBase& operator=(MoveOnlyFunctionBase&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    MoveOnlyFunctionBase& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename Target,
+              typename = std::enable_if_t<!std::is_base_of_v<MoveOnlyFunctionBase, std::decay_t<Target>> &&
+                                          IsInvocable<std::decay_t<Target>>>>
+    MoveOnlyFunctionBase& operator=(Target&& t) {
+        reset();
+        emplace(std::forward<Target>(t));
+        return *this;
+    }
+
+    ~MoveOnlyFunctionBase() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return invoker_ != &emptyInvoker;
+    }
+
+protected:
+    // Gets the buffer, which either holds the target or a pointer to it. Keeping the two cases
+    // apart in separate invokers means that calling never branches on the storage mode.
+    using Invoker = R(*)(void* buffer, Args&&...) noexcept(Noexcept);
+
+    void* buffer() const noexcept {
+        return const_cast<void*>(static_cast<const void*>(&buffer_));
+    }
+
+    Invoker invoker_ = &emptyInvoker;
+
+private:
+    enum class Op {
+        Move,
+        Destroy,
+    };
+
+    using Manager = void(*)(Op, void* from, void* to) noexcept;
+
+    static R emptyInvoker(void*, Args&&...) noexcept(Noexcept) {
+        if constexpr (Noexcept) {
+            std::terminate();
+        } else {
+            throw std::bad_function_call();
+        }
+    }
+
+    // Void signatures accept targets which return something, the result is discarded
+    template <typename D>
+    static R invokeTarget(D& target, Args&&... args) noexcept(Noexcept) {
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(static_cast<Callee<D>>(target), std::forward<Args>(args)...);
+        } else {
+            return std::invoke(static_cast<Callee<D>>(target), std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename Target>
+    void emplace(Target&& t) {
+        using D = std::decay_t<Target>;
+        if constexpr (std::is_pointer_v<D> || std::is_member_pointer_v<D>) {
+            // Like std::function, a null function or member pointer gives an empty function
+            if (t == nullptr) {
+                return;
+            }
+        }
+        if constexpr (StoredInline<D>) {
+            new (&buffer_) D(std::forward<Target>(t));
+            invoker_ = [](void* buffer, Args&&... args) noexcept(Noexcept) -> R {
+                return invokeTarget(*static_cast<D*>(buffer), std::forward<Args>(args)...);
+            };
+            if constexpr (std::is_trivially_copyable_v<D>) {
+                // Moving copies only the target's bytes and destroying is a no-op
+                manager_ = [](Op op, void* from, void* to) noexcept {
+                    if (op == Op::Move) {
+                        RelocateTrivially<D>(from, to);
+                    }
+                };
+            } else {
+                manager_ = [](Op op, void* from, void* to) noexcept {
+                    auto& target = *static_cast<D*>(from);
+                    if (op == Op::Move) {
+                        new (to) D(std::move(target));
+                    }
+                    target.~D();
+                };
+            }
+        } else {
+            auto ptr = Allocator::template allocate<D>();
+            if constexpr (std::is_nothrow_constructible_v<D, Target>) {
+                new (ptr) D(std::forward<Target>(t));
+            } else {
+                try {
+                    new (ptr) D(std::forward<Target>(t));
+                } catch (...) {
+                    Allocator::template deallocate<D>(ptr);
+                    throw;
+                }
+            }
+            *static_cast<void**>(buffer()) = ptr;
+            invoker_ = [](void* buffer, Args&&... args) noexcept(Noexcept) -> R {
+                return invokeTarget(**static_cast<D**>(buffer), std::forward<Args>(args)...);
+            };
+            // Moving only transfers the pointer
+            manager_ = [](Op op, void* from, void* to) noexcept {
+                auto target = *static_cast<D**>(from);
+                if (op == Op::Move) {
+                    *static_cast<D**>(to) = target;
+                } else {
+                    target->~D();
+                    Allocator::template deallocate<D>(target);
+                }
+            };
+        }
+    }
+
+    void reset() noexcept {
+        if (manager_) {
+            manager_(Op::Destroy, &buffer_, nullptr);
+            manager_ = nullptr;
+        }
+        invoker_ = &emptyInvoker;
+    }
+
+    void moveFrom(MoveOnlyFunctionBase& other) noexcept {
+        // The buffer of an empty function is uninitialized
+        if (!other) {
+            return;
+        }
+        other.manager_(Op::Move, &other.buffer_, &buffer_);
+        invoker_ = std::exchange(other.invoker_, &emptyInvoker);
+        manager_ = std::exchange(other.manager_, nullptr);
+    }
+
+    Manager manager_ = nullptr;
+    std::aligned_storage_t<InlineBytes, alignof(std::max_align_t)> buffer_;
+};
+}
+
+template <typename Signature, std::size_t InlineBytes = 4 * sizeof(void*),
+          typename Allocator = DefaultFunctionAllocator>
+class MoveOnlyFunction;
+
+// Like std::function, but targets only need to be movable, so callables which capture a
+// unique_ptr or a UniqueFd can be stored without boxing them in a shared_ptr :
+// MoveOnlyFunction<void()> task = [buffer = std::make_unique<Buffer>()]() { send(*buffer); };
+// Targets up to InlineBytes which are nothrow movable live in the inline buffer, larger ones
+// are allocated through Allocator (see DefaultFunctionAllocator and PooledFunctionAllocator).
+// The signature may be const and/or noexcept qualified, in which case only targets which are
+// callable as const and/or noexcept are accepted :
+// MoveOnlyFunction<int(int) const noexcept> f = [](int x) noexcept { return x + 1; };
+// Every combination has its own invoker type, so a noexcept signature calls through a noexcept
+// function pointer. Calling an empty function throws std::bad_function_call, or terminates
+// for noexcept signatures.
+#define SH_MOVE_ONLY_FUNCTION(CONST, IS_CONST, NOEXCEPT, IS_NOEXCEPT) \
+template <typename R, typename... Args, std::size_t InlineBytes, typename Allocator> \
+class MoveOnlyFunction<R(Args...) CONST NOEXCEPT, InlineBytes, Allocator> \
+    : public detail::MoveOnlyFunctionBase<InlineBytes, Allocator, IS_CONST, IS_NOEXCEPT, R, Args...> { \
+    using Base = detail::MoveOnlyFunctionBase<InlineBytes, Allocator, IS_CONST, IS_NOEXCEPT, R, Args...>; \
+public: \
+    using Base::Base; \
+    using Base::operator=; \
+    \
+    R operator()(Args... args) CONST NOEXCEPT { \
+        return this->invoker_(this->buffer(), std::forward<Args>(args)...); \
+    } \
+};
+
+SH_MOVE_ONLY_FUNCTION(, false, , false)
+SH_MOVE_ONLY_FUNCTION(const, true, , false)
+SH_MOVE_ONLY_FUNCTION(, false, noexcept, true)
+SH_MOVE_ONLY_FUNCTION(const, true, noexcept, true)
+#undef SH_MOVE_ONLY_FUNCTION
+}
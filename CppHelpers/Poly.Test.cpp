@@ -0,0 +1,136 @@
+//
+//  Poly.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ArrayVector.h"
+#include "Poly.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace {
+struct Shape : sh::PolyInterface<double() const, void(double), std::string() const> {
+    template <typename T>
+    static constexpr auto Impl = std::make_tuple(&T::area, &T::scale, [](const T& t) { return t.name(); });
+
+    template <typename Self>
+    struct Api {
+        double area() const { return static_cast<const Self&>(*this).template invoke<0>(); }
+        void scale(double factor) { static_cast<Self&>(*this).template invoke<1>(factor); }
+        std::string name() const { return static_cast<const Self&>(*this).template invoke<2>(); }
+    };
+};
+
+struct Square {
+    double side;
+    double area() const { return side * side; }
+    void scale(double factor) { side *= factor; }
+    std::string name() const { return "square"; }
+};
+
+// Not trivially copyable, and larger than a Square
+struct Rectangle {
+    static inline int alive = 0;
+    Rectangle(double w, double h) : width(w), height(h) { alive++; }
+    Rectangle(Rectangle&& other) noexcept : width(other.width), height(other.height) { alive++; }
+    ~Rectangle() { alive--; }
+    double area() const { return width * height; }
+    void scale(double factor) { width *= factor; height *= factor; }
+    std::string name() const { return "rectangle"; }
+    double width;
+    double height;
+    std::unique_ptr<int> unused;
+};
+
+struct Faulty {
+    Faulty() { throw std::runtime_error("construction failed"); }
+    double area() const { return 0; }
+    void scale(double) {}
+    std::string name() const { return "faulty"; }
+};
+
+template <sh::VTableStorage Storage>
+using ShapePoly = sh::Poly<Shape, 48, Storage>;
+}
+
+TEST_CASE("[Poly] static asserts") {
+    using Static = ShapePoly<sh::VTableStorage::Static>;
+    using Inline = ShapePoly<sh::VTableStorage::Inline>;
+    static_assert(!std::is_copy_constructible_v<Static>);
+    static_assert(std::is_nothrow_move_constructible_v<Static>);
+    static_assert(sizeof(Static) == 48 + alignof(std::max_align_t));
+    // The inline table holds the type tag, relocate, destroy and the three methods
+    static_assert(sizeof(Inline) >= 48 + 6 * sizeof(void*));
+    static_assert(!std::is_invocable_v<decltype(&Static::scale), const Static&, double>);
+}
+
+TEMPLATE_TEST_CASE_SIG("[Poly] calls through the interface", "",
+                       ((sh::VTableStorage Storage), Storage), sh::VTableStorage::Static, sh::VTableStorage::Inline) {
+    Rectangle::alive = 0;
+
+    SECTION("Methods dispatch to the stored type") {
+        ShapePoly<Storage> shape = Square{2};
+        REQUIRE(shape.area() == 4);
+        shape.scale(2);
+        REQUIRE(shape.area() == 16);
+        REQUIRE(shape.name() == "square");
+        REQUIRE(shape.template holds<Square>());
+        REQUIRE(shape.template get<Square>()->side == 4);
+        REQUIRE(shape.template get<Rectangle>() == nullptr);
+
+        shape.template emplace<Rectangle>(2, 3);
+        REQUIRE(shape.area() == 6);
+        REQUIRE(shape.name() == "rectangle");
+    }
+
+    SECTION("Emplace keeps the current object if construction throws") {
+        ShapePoly<Storage> shape = Rectangle(2, 3);
+        REQUIRE_THROWS_AS(shape.template emplace<Faulty>(), std::runtime_error);
+        REQUIRE(shape.template holds<Rectangle>());
+        REQUIRE(shape.area() == 6);
+        REQUIRE(Rectangle::alive == 1);
+
+        // Arguments may refer to the current object
+        shape.template emplace<Rectangle>(std::move(*shape.template get<Rectangle>()));
+        REQUIRE(shape.area() == 6);
+        REQUIRE(Rectangle::alive == 1);
+    }
+
+    SECTION("Move and destroy") {
+        {
+            ShapePoly<Storage> first = Rectangle(1, 2);
+            REQUIRE(Rectangle::alive == 1);
+            auto second = std::move(first);
+            REQUIRE_FALSE(first.hasValue());
+            REQUIRE(second.area() == 2);
+            REQUIRE(Rectangle::alive == 1);
+            second = ShapePoly<Storage>(Square{1});
+            REQUIRE(Rectangle::alive == 0);
+            first = Rectangle(1, 1);
+        }
+        REQUIRE(Rectangle::alive == 0);
+    }
+
+    SECTION("Contiguous storage in containers") {
+        sh::ArrayVector<ShapePoly<Storage>, 4> shapes;
+        shapes.emplace_back(Square{1});
+        shapes.emplace_back(Rectangle(2, 3));
+        shapes.emplace_back(Square{3});
+        double total = 0;
+        for (auto& shape : shapes) {
+            shape.scale(2);
+            total += shape.area();
+        }
+        REQUIRE(total == 4 + 24 + 36);
+        REQUIRE(reinterpret_cast<char*>(&shapes[1]) - reinterpret_cast<char*>(&shapes[0]) ==
+                sizeof(ShapePoly<Storage>));
+    }
+}
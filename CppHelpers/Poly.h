@@ -0,0 +1,271 @@
+//
+//  Poly.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Relocatable.h"
+
+namespace sh {
+namespace detail {
+// How a method signature is called through the vtable. The object is passed as the first
+// argument, as a const pointer for const methods.
+template <typename Signature>
+struct PolyMethod;
+
+template <typename R, typename... Args>
+struct PolyMethod<R(Args...)> {
+    using Fn = R (*)(void*, Args...);
+
+    template <typename Interface, typename T, std::size_t I>
+    static R call(void* self, Args... args) {
+        return std::invoke(std::get<I>(Interface::template Impl<T>), *static_cast<T*>(self),
+                           std::forward<Args>(args)...);
+    }
+};
+
+template <typename R, typename... Args>
+struct PolyMethod<R(Args...) const> {
+    using Fn = R (*)(const void*, Args...);
+
+    template <typename Interface, typename T, std::size_t I>
+    static R call(const void* self, Args... args) {
+        return std::invoke(std::get<I>(Interface::template Impl<T>), *static_cast<const T*>(self),
+                           std::forward<Args>(args)...);
+    }
+};
+
+// Its address identifies the stored type, so Poly::holds() doesn't need RTTI. Not const, like
+// TEContainerTypeTag, so that identical code folding can't merge the tags of two types.
+template <typename T>
+inline char PolyTypeTag = 0;
+
+template <typename... Signatures>
+struct PolyVTable {
+    // nullptr for empty Polys
+    const void* type;
+    // Moves the object and destroys the source
+    void (*relocate)(void* from, void* to) noexcept;
+    // nullptr for trivially destructible objects
+    void (*destroy)(void* object) noexcept;
+    std::tuple<typename PolyMethod<Signatures>::Fn...> methods;
+
+    template <typename Interface, typename T>
+    static constexpr PolyVTable make() noexcept {
+        return make<Interface, T>(std::index_sequence_for<Signatures...>{});
+    }
+
+private:
+    template <typename Interface, typename T, std::size_t... I>
+    static constexpr PolyVTable make(std::index_sequence<I...>) noexcept {
+        return {
+            &PolyTypeTag<T>,
+            &relocateImpl<T>,
+            std::is_trivially_destructible_v<T> ? nullptr : &destroyImpl<T>,
+            {&PolyMethod<Signatures>::template call<Interface, T, I>...},
+        };
+    }
+
+    template <typename T>
+    static void relocateImpl(void* from, void* to) noexcept {
+        if constexpr (IsTriviallyRelocatable_v<T>) {
+            RelocateTrivially<T>(from, to);
+        } else {
+            auto& source = *static_cast<T*>(from);
+            new (to) T(std::move(source));
+            source.~T();
+        }
+    }
+
+    template <typename T>
+    static void destroyImpl(void* object) noexcept {
+        static_cast<T*>(object)->~T();
+    }
+};
+}
+
+// Interfaces for Poly derive from this, listing their method signatures in order
+template <typename... Signatures>
+struct PolyInterface {
+    using VTable = detail::PolyVTable<Signatures...>;
+};
+
+// Where Poly keeps its table of function pointers. A static table costs one pointer per object
+// and an extra load per call, an inline copy costs a pointer per method but calls only touch
+// the object itself.
+enum class VTableStorage {
+    Static,
+    Inline,
+};
+
+// Polymorphic value without inheritance or heap allocation, an alternative to keeping objects
+// behind unique_ptr<Base>. The object lives in the inline buffer (types which don't fit fail to
+// compile), and methods are called through a table of capture-less trampolines, one table per
+// stored type. Any type which provides the methods can be stored, it doesn't need a common base.
+// Since the objects are stored inline, a container of Polys keeps polymorphic objects
+// contiguous, eg. ArrayVector<Poly<Shape, 48>, 16>.
+// An interface is declared once, as a list of signatures, the mapping from each method to the
+// stored type (member function pointers or lambdas taking the object first) and the named
+// functions that Poly exposes :
+// struct Shape : PolyInterface<double() const, void(double)> {
+//     template <typename T>
+//     static constexpr auto Impl = std::make_tuple(&T::area, &T::scale);
+//
+//     template <typename Self>
+//     struct Api {
+//         double area() const { return static_cast<const Self&>(*this).template invoke<0>(); }
+//         void scale(double f) { static_cast<Self&>(*this).template invoke<1>(f); }
+//     };
+// };
+// Poly<Shape> shape = Circle{1.0};
+// shape.scale(2.0);
+// Polys are move-only, like the unique_ptrs they replace. A default constructed or moved-from
+// Poly is empty, and calling methods on it is UB.
+template <typename Interface, std::size_t InlineBytes = 4 * sizeof(void*),
+          VTableStorage Storage = VTableStorage::Static>
+class Poly : public Interface::template Api<Poly<Interface, InlineBytes, Storage>> {
+    using VTable = typename Interface::VTable;
+
+public:
+    Poly() noexcept = default;
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Poly>>>
+    Poly(T&& value) noexcept(std::is_nothrow_constructible_v<std::decay_t<T>, T>) {
+        emplace<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    Poly(const Poly&) = delete;
+    Poly& operator=(const Poly&) = delete;
+
+    Poly(Poly&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Poly& operator=(Poly&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    ~Poly() {
+        reset();
+    }
+
+    // Constructs a T and replaces the current object (if any) with it. The T is constructed
+    // before the current object is destroyed, so args may refer to it. If the constructor
+    // throws, the current object is kept.
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(std::is_same_v<T, std::decay_t<T>>, "Cannot store references or arrays");
+        static_assert(sizeof(T) <= InlineBytes, "Object doesn't fit in the inline buffer");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Object is over-aligned for the inline buffer");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "Objects must be nothrow movable");
+        T* value;
+        if (hasValue()) {
+            // The buffer is still in use, build the object aside and move it in (nothrow)
+            T temporary(std::forward<Args>(args)...);
+            reset();
+            value = new (&buffer_) T(std::move(temporary));
+        } else {
+            value = new (&buffer_) T(std::forward<Args>(args)...);
+        }
+        if constexpr (Storage == VTableStorage::Static) {
+            table_ = &Table<T>;
+        } else {
+            table_ = Table<T>;
+        }
+        return *value;
+    }
+
+    void reset() noexcept {
+        if (vtable().destroy) {
+            vtable().destroy(&buffer_);
+        }
+        table_ = Empty;
+    }
+
+    bool hasValue() const noexcept {
+        return vtable().type != nullptr;
+    }
+
+    template <typename T>
+    bool holds() const noexcept {
+        return vtable().type == &detail::PolyTypeTag<T>;
+    }
+
+    // Returns a pointer to the stored object if it is a T, nullptr otherwise
+    template <typename T>
+    T* get() noexcept {
+        return holds<T>() ? reinterpret_cast<T*>(&buffer_) : nullptr;
+    }
+
+    template <typename T>
+    const T* get() const noexcept {
+        return holds<T>() ? reinterpret_cast<const T*>(&buffer_) : nullptr;
+    }
+
+    // Calls the I-th method of the interface, this is what the interface's Api forwards to.
+    // Non-const methods can't be called on a const Poly.
+    template <std::size_t I, typename... Args>
+    decltype(auto) invoke(Args&&... args) {
+        assert(hasValue());
+        return std::get<I>(vtable().methods)(static_cast<void*>(&buffer_), std::forward<Args>(args)...);
+    }
+
+    template <std::size_t I, typename... Args>
+    decltype(auto) invoke(Args&&... args) const {
+        assert(hasValue());
+        return std::get<I>(vtable().methods)(static_cast<const void*>(&buffer_), std::forward<Args>(args)...);
+    }
+
+private:
+    template <typename T>
+    static constexpr VTable Table = VTable::template make<Interface, T>();
+
+    static constexpr VTable EmptyTable{};
+
+    using TableHolder = std::conditional_t<Storage == VTableStorage::Static, const VTable*, VTable>;
+
+    static constexpr TableHolder Empty = [] {
+        if constexpr (Storage == VTableStorage::Static) {
+            return &EmptyTable;
+        } else {
+            return EmptyTable;
+        }
+    }();
+
+    const VTable& vtable() const noexcept {
+        if constexpr (Storage == VTableStorage::Static) {
+            return *table_;
+        } else {
+            return table_;
+        }
+    }
+
+    void moveFrom(Poly& other) noexcept {
+        // The buffer of an empty Poly is uninitialized
+        if (!other.hasValue()) {
+            return;
+        }
+        other.vtable().relocate(&other.buffer_, &buffer_);
+        table_ = std::exchange(other.table_, Empty);
+    }
+
+    TableHolder table_ = Empty;
+    std::aligned_storage_t<InlineBytes, alignof(std::max_align_t)> buffer_;
+};
+}
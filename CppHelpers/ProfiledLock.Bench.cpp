@@ -0,0 +1,31 @@
+//
+//  ProfiledLock.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "ProfiledLock.h"
+
+#include <mutex>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("Uncontended lock overhead", "[!benchmark][ProfiledLockGuard]") {
+    static sh::LockSite site("Uncontended lock overhead");
+    std::mutex mutex;
+    int counter = 0;
+
+    BENCHMARK("std::lock_guard") {
+        std::lock_guard<std::mutex> guard(mutex);
+        return ++counter;
+    };
+
+    BENCHMARK("ProfiledLockGuard") {
+        sh::ProfiledLockGuard<std::mutex> guard(mutex, site);
+        return ++counter;
+    };
+}
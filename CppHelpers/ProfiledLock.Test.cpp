@@ -0,0 +1,126 @@
+//
+//  ProfiledLock.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ProfiledLock.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+class SpinLock {
+public:
+    void lock() noexcept {
+        while (locked_.exchange(true, std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool try_lock() noexcept {
+        return !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept {
+        locked_.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> locked_{false};
+};
+}
+
+TEMPLATE_TEST_CASE("[ProfiledLockGuard] records acquisitions", "", std::mutex, SpinLock) {
+    sh::LockSite site("records acquisitions");
+    TestType mutex;
+
+    SECTION("Uncontended") {
+        for (int i = 0; i < 10; i++) {
+            sh::ProfiledLockGuard<TestType> guard(mutex, site);
+        }
+        auto snapshot = site.snapshot();
+        REQUIRE(snapshot.acquisitions() == 10);
+        REQUIRE(snapshot.contended == 0);
+        REQUIRE(snapshot.wait.count() == 10);
+        REQUIRE(snapshot.wait.percentile(1.0) == 0);
+    }
+
+    SECTION("Contended") {
+        std::atomic<bool> waiting{false};
+        std::thread thread;
+        {
+            sh::ProfiledLockGuard<TestType> guard(mutex, site);
+            thread = std::thread([&]() {
+                waiting = true;
+                sh::ProfiledLockGuard<TestType> guard(mutex, site);
+            });
+            while (!waiting) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        thread.join();
+
+        auto snapshot = site.snapshot();
+        REQUIRE(snapshot.acquisitions() == 2);
+        REQUIRE(snapshot.contended == 1);
+        REQUIRE(sh::TimerSite::toNanoseconds(snapshot.wait.percentile(1.0)) > 1e6);
+        REQUIRE(sh::TimerSite::toNanoseconds(snapshot.hold.percentile(1.0)) > 1e6);
+    }
+}
+
+TEST_CASE("[ProfiledLockGuard] periodic snapshots") {
+    sh::LockSite site("periodic snapshots");
+    std::mutex mutex;
+    for (int i = 0; i < 5; i++) {
+        sh::ProfiledLockGuard<std::mutex> guard(mutex, site);
+    }
+    auto first = site.snapshot();
+    for (int i = 0; i < 3; i++) {
+        sh::ProfiledLockGuard<std::mutex> guard(mutex, site);
+    }
+    auto delta = site.snapshot().since(first);
+    REQUIRE(delta.acquisitions() == 3);
+    REQUIRE(delta.wait.count() == 3);
+    REQUIRE(delta.contended == 0);
+}
+
+TEST_CASE("[ProfiledLockGuard] macro registers a named site") {
+    std::mutex mutex;
+    auto lockOnce = [&]() {
+        SH_PROFILED_LOCK(mutex, "ProfiledLock.Test");
+    };
+    lockOnce();
+    lockOnce();
+
+    std::uint64_t acquisitions = 0;
+    sh::LockSite::forEach([&](const sh::LockSite& site) {
+        if (site.name() == "ProfiledLock.Test") {
+            acquisitions = site.snapshot().acquisitions();
+        }
+    });
+    REQUIRE(acquisitions == 2);
+}
+
+TEST_CASE("[ProfiledLockGuard] destroyed sites are unlinked") {
+    auto isListed = [](std::string_view name) {
+        bool found = false;
+        sh::LockSite::forEach([&](const sh::LockSite& site) { found = found || site.name() == name; });
+        return found;
+    };
+    {
+        sh::LockSite first("destroyed site 1");
+        sh::LockSite second("destroyed site 2");
+        REQUIRE(isListed("destroyed site 1"));
+        REQUIRE(isListed("destroyed site 2"));
+    }
+    REQUIRE_FALSE(isListed("destroyed site 1"));
+    REQUIRE_FALSE(isListed("destroyed site 2"));
+}
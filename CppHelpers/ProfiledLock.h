@@ -0,0 +1,134 @@
+//
+//  ProfiledLock.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "ScopedTimer.h"
+
+namespace sh {
+// Contention statistics of a named lock, usually declared through SH_PROFILED_LOCK. Like
+// TimerSite, every thread records into its own counters so profiling doesn't add contention
+// of its own. Also like TimerSite, sites are meant to be function-local statics and are
+// enumerated through forEach(), see detail::SiteRegistry.
+class LockSite : public detail::SiteRegistry<LockSite, 256> {
+public:
+    // Values are in clock ticks, see TimerSite::toNanoseconds()
+    struct Snapshot {
+        // Time spent waiting for the lock, 0 for uncontended acquisitions
+        LatencyHistogram::Snapshot wait;
+        LatencyHistogram::Snapshot hold;
+        // Acquisitions where try_lock failed, ie. the lock was contended
+        std::uint64_t contended = 0;
+
+        std::uint64_t acquisitions() const noexcept {
+            return hold.count();
+        }
+
+        // Activity between earlier and this snapshot of the same site, for periodic reporting
+        Snapshot since(const Snapshot& earlier) const noexcept {
+            return {wait.since(earlier.wait), hold.since(earlier.hold), contended - earlier.contended};
+        }
+    };
+
+    // Counters of a single thread, only ever written by that thread
+    struct Stats {
+        LatencyHistogram wait;
+        LatencyHistogram hold;
+        std::atomic<std::uint64_t> contended{0};
+    };
+
+    explicit LockSite(std::string_view name)
+        : SiteRegistry("Too many lock sites"), name_(name), stats_(index()) {
+        link();
+    }
+
+    Stats& local() {
+        return stats_.local();
+    }
+
+    // Aggregates the counters of all threads
+    Snapshot snapshot() const {
+        Snapshot snapshot;
+        stats_.forEach([&](const Stats& stats) {
+            snapshot.wait.add(stats.wait);
+            snapshot.hold.add(stats.hold);
+            snapshot.contended += stats.contended.load(std::memory_order_relaxed);
+        });
+        return snapshot;
+    }
+
+    std::string_view name() const noexcept {
+        return name_;
+    }
+
+private:
+    std::string_view name_;
+    detail::PerThreadList<Stats, MaxSites> stats_;
+};
+
+// Drop-in for std::lock_guard which records how long the lock was waited for and held. Works
+// with any Lockable type (lock, try_lock and unlock), eg. std::mutex or a spinlock.
+// The lock is first attempted with try_lock, so uncontended acquisitions skip the wait
+// timestamps and only contended ones pay for measuring the wait. Like StackGuard, this is
+// meant for scope-based usage.
+// Prefer SH_PROFILED_LOCK, which falls back to std::lock_guard when SH_DISABLE_LOCK_PROFILING
+// is defined.
+template <typename Mutex>
+class ProfiledLockGuard : NonCopyable, NonMovable {
+public:
+    ProfiledLockGuard(Mutex& mutex, LockSite& site) : mutex_(mutex), stats_(site.local()) {
+        if (mutex_.try_lock()) {
+            stats_.wait.record(0);
+        } else {
+            auto& contended = stats_.contended;
+            contended.store(contended.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            const auto start = detail::TimerTicks();
+            mutex_.lock();
+            stats_.wait.record(detail::TimerTicks() - start);
+        }
+        acquired_ = detail::TimerTicks();
+    }
+
+    ~ProfiledLockGuard() {
+        const auto held = detail::TimerTicks() - acquired_;
+        mutex_.unlock();
+        // Recorded after unlocking so that profiling doesn't extend the critical section
+        stats_.hold.record(held);
+    }
+
+private:
+    Mutex& mutex_;
+    LockSite::Stats& stats_;
+    std::uint64_t acquired_;
+};
+}
+
+#ifdef SH_DISABLE_LOCK_PROFILING
+#define SH_PROFILED_LOCK(mutex, name) \
+    std::lock_guard<std::decay_t<decltype(mutex)>> SH_TIMER_CONCAT(shLockGuard, __LINE__)(mutex)
+#else
+// Locks mutex for the rest of the enclosing scope and records the statistics under the given
+// name. Example :
+// void push(int value) {
+//     SH_PROFILED_LOCK(mutex_, "Queue::push");
+//     items_.push_back(value);
+// }
+#define SH_PROFILED_LOCK(mutex, name) \
+    static sh::LockSite SH_TIMER_CONCAT(shLockSite, __LINE__)(name); \
+    sh::ProfiledLockGuard<std::decay_t<decltype(mutex)>> SH_TIMER_CONCAT(shLockGuard, __LINE__)( \
+        mutex, SH_TIMER_CONCAT(shLockSite, __LINE__))
+#endif
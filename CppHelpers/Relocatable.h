@@ -0,0 +1,39 @@
+//
+//  Relocatable.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+namespace sh {
+// A type is trivially relocatable if moving an object to a new address and ending the lifetime
+// of the source is equivalent to a memcpy of its bytes, ie. nothing refers back to the object's
+// own address. Containers use this to move elements with memcpy and skip destroying the
+// moved-from originals.
+// This holds for every trivially copyable type, other types (eg. handle wrappers with a
+// non-trivial destructor) opt in by specializing the trait :
+// template <>
+// struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template <typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_move_constructible_v<T> &&
+                                                   std::is_trivially_destructible_v<T>> {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatable_v = IsTriviallyRelocatable<T>::value;
+
+// Relocates a trivially relocatable T between two buffers, with the signature type-erased
+// wrappers use for their relocate functions. Only sizeof(T) bytes are copied, so wrappers with
+// inline buffers (InplaceFunction, MoveOnlyFunction, Poly, Task) never copy the unused (and
+// uninitialized) rest of their buffer.
+template <typename T>
+void RelocateTrivially(void* from, void* to) noexcept {
+    static_assert(IsTriviallyRelocatable_v<T>, "T must be trivially relocatable");
+    std::memcpy(to, from, sizeof(T));
+}
+}
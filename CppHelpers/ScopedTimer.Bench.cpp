@@ -0,0 +1,30 @@
+//
+//  ScopedTimer.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "ScopedTimer.h"
+
+#include <chrono>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("ScopedTimer probe cost", "[!benchmark][ScopedTimer]") {
+    int value = 0;
+    
+    BENCHMARK("SH_SCOPED_TIMER") {
+        SH_SCOPED_TIMER("probe cost");
+        return ++value;
+    };
+    
+    BENCHMARK("steady_clock pair (hand-written)") {
+        auto start = std::chrono::steady_clock::now();
+        ++value;
+        return std::chrono::steady_clock::now() - start;
+    };
+}
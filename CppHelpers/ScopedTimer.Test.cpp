@@ -0,0 +1,107 @@
+//
+//  ScopedTimer.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ScopedTimer.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("[LatencyHistogram] bucket boundaries") {
+    using H = sh::LatencyHistogram;
+    static_assert(H::bucketFor(0) == 0);
+    static_assert(H::bucketFor(7) == 7);
+    static_assert(H::bucketFor(8) == 8);
+    static_assert(H::bucketFor(15) == 15);
+    static_assert(H::bucketFor(16) == 16);
+    static_assert(H::bucketFor(17) == 16);
+    static_assert(H::bucketFor(~0ull) == H::BucketCount - 1);
+    
+    for (std::size_t bucket = 0; bucket < H::BucketCount; bucket++) {
+        REQUIRE(H::bucketFor(H::lowerBound(bucket)) == bucket);
+        REQUIRE(H::bucketFor(H::upperBound(bucket)) == bucket);
+        if (bucket + 1 < H::BucketCount) {
+            REQUIRE(H::upperBound(bucket) + 1 == H::lowerBound(bucket + 1));
+        }
+    }
+}
+
+TEST_CASE("[LatencyHistogram] percentiles") {
+    sh::LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 1000; i++) {
+        histogram.record(i);
+    }
+    sh::LatencyHistogram::Snapshot snapshot;
+    snapshot.add(histogram);
+    REQUIRE(snapshot.count() == 1000);
+    
+    // Within the relative error of a bucket
+    REQUIRE(snapshot.p50() >= 500);
+    REQUIRE(snapshot.p50() <= 500 + 500 / sh::LatencyHistogram::SubBuckets);
+    REQUIRE(snapshot.p99() >= 990);
+    REQUIRE(snapshot.p99() <= 990 + 990 / sh::LatencyHistogram::SubBuckets);
+    REQUIRE(snapshot.p999() >= 999);
+    
+    sh::LatencyHistogram::Snapshot empty;
+    REQUIRE(empty.p99() == 0);
+}
+
+TEST_CASE("[ScopedTimer] aggregates across threads") {
+    static sh::TimerSite site("aggregates across threads");
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([]() {
+            for (int j = 0; j < 100; j++) {
+                sh::ScopedTimer timer(site);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    {
+        sh::ScopedTimer timer(site);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto snapshot = site.snapshot();
+    REQUIRE(snapshot.count() == 401);
+    // The sleep is the slowest sample by far
+    REQUIRE(sh::TimerSite::toNanoseconds(snapshot.percentile(1.0)) >= 1000000);
+    REQUIRE(sh::TimerSite::toNanoseconds(snapshot.p50()) < 1000000);
+}
+
+TEST_CASE("[ScopedTimer] macro registers a named site") {
+    for (int i = 0; i < 3; i++) {
+        SH_SCOPED_TIMER("macro registers a named site");
+    }
+    std::uint64_t count = 0;
+    sh::TimerSite::forEach([&](const sh::TimerSite& site) {
+        if (site.name() == "macro registers a named site") {
+            count = site.snapshot().count();
+        }
+    });
+    REQUIRE(count == 3);
+}
+
+TEST_CASE("[ScopedTimer] destroyed sites are unlinked") {
+    auto isListed = [](std::string_view name) {
+        bool found = false;
+        sh::TimerSite::forEach([&](const sh::TimerSite& site) { found = found || site.name() == name; });
+        return found;
+    };
+    {
+        sh::TimerSite first("destroyed site 1");
+        sh::TimerSite second("destroyed site 2");
+        REQUIRE(isListed("destroyed site 1"));
+        REQUIRE(isListed("destroyed site 2"));
+    }
+    REQUIRE_FALSE(isListed("destroyed site 1"));
+    REQUIRE_FALSE(isListed("destroyed site 2"));
+}
@@ -0,0 +1,372 @@
+//
+//  ScopedTimer.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+namespace detail {
+// Raw timestamp in clock ticks. rdtsc where available since it's by far the cheapest option,
+// CLOCK_MONOTONIC_RAW (in nanoseconds) otherwise.
+inline std::uint64_t TimerTicks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+// Calibrated once on first use, which is never on the probe path (only when querying)
+inline double TimerTicksPerNanosecond() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ticksPerNs = []() {
+        using Clock = std::chrono::steady_clock;
+        const auto startTime = Clock::now();
+        const auto startTicks = TimerTicks();
+        while (Clock::now() - startTime < std::chrono::milliseconds(10)) {}
+        const auto ticks = TimerTicks() - startTicks;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime);
+        return static_cast<double>(ticks) / ns.count();
+    }();
+    return ticksPerNs;
+#else
+    return 1.0;
+#endif
+}
+
+constexpr unsigned MostSignificantBit(std::uint64_t value) noexcept {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    unsigned msb = 0;
+    while (value >>= 1) {
+        msb++;
+    }
+    return msb;
+#endif
+}
+
+// Per-thread instances of Value owned by a site (see TimerSite and LockSite). Every thread gets
+// its own Value the first time it calls local(), so updating it never contends. Values are
+// linked into a lock-free list and live as long as the site, which means values of threads
+// that have exited can still be read.
+// Sites are numbered [0, MaxSites) so that the per-thread lookup is an index into a plain
+// thread_local array.
+template <typename Value, std::size_t MaxSites>
+class PerThreadList : NonCopyable, NonMovable {
+public:
+    explicit PerThreadList(std::size_t index) noexcept : index_(index) {}
+
+    ~PerThreadList() {
+        auto node = head_.load(std::memory_order_acquire);
+        while (node) {
+            auto next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    Value& local() {
+        auto& slot = threadValues()[index_];
+        if (!slot) {
+            auto node = new Node;
+            node->next = head_.load(std::memory_order_relaxed);
+            while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release)) {}
+            slot = &node->value;
+        }
+        return *slot;
+    }
+
+    // Calls fn(const Value&) for the values of all threads
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (auto node = head_.load(std::memory_order_acquire); node; node = node->next) {
+            fn(static_cast<const Value&>(node->value));
+        }
+    }
+
+private:
+    struct Node {
+        Value value;
+        Node* next = nullptr;
+    };
+
+    // Kept trivially destructible so that the lookup is a plain TLS access
+    static std::array<Value*, MaxSites>& threadValues() noexcept {
+        static thread_local std::array<Value*, MaxSites> values{};
+        return values;
+    }
+
+    const std::size_t index_;
+    std::atomic<Node*> head_{nullptr};
+};
+
+// Process-wide list of the sites of one kind (see TimerSite and LockSite), as a CRTP base.
+// Hands out the site's index for PerThreadList and lets forEach() enumerate the live sites.
+// Sites are meant to be function-local statics. Shorter lived sites are unlinked from the list
+// when they are destroyed, but their index isn't reused, so at most MaxSites sites can ever be
+// created.
+template <typename Site, std::size_t Capacity>
+class SiteRegistry : NonCopyable, NonMovable {
+public:
+    // Maximum number of sites in the process, the per-thread lookup table is sized by this
+    static constexpr std::size_t MaxSites = Capacity;
+
+    // Calls fn(const Site&) for every site in the process. Sites can't be created or destroyed
+    // in the meantime, so fn must not create or destroy sites itself.
+    template <typename Fn>
+    static void forEach(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (auto site = sites(); site; site = site->next_) {
+            fn(static_cast<const Site&>(*site));
+        }
+    }
+
+protected:
+    // Throws tooMany once MaxSites sites have been created
+    explicit SiteRegistry(const char* tooMany) : index_(nextIndex()++) {
+        if (index_ >= MaxSites) {
+            throw std::runtime_error(tooMany);
+        }
+    }
+
+    // A site that is destroyed before link() (ie. its constructor threw) was never listed
+    ~SiteRegistry() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        auto link = &sites();
+        while (*link && *link != this) {
+            link = &(*link)->next_;
+        }
+        if (*link) {
+            *link = next_;
+        }
+    }
+
+    // Called at the end of the derived constructor, so that forEach() never sees a partially
+    // constructed site
+    void link() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        next_ = sites();
+        sites() = this;
+    }
+
+    std::size_t index() const noexcept {
+        return index_;
+    }
+
+private:
+    static std::atomic<std::size_t>& nextIndex() noexcept {
+        static std::atomic<std::size_t> index{0};
+        return index;
+    }
+
+    // Guards the list of sites, which is only touched when sites are created, destroyed or
+    // enumerated, never when recording
+    static std::mutex& registryMutex() noexcept {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static SiteRegistry*& sites() noexcept {
+        static SiteRegistry* head = nullptr;
+        return head;
+    }
+
+    const std::size_t index_;
+    SiteRegistry* next_ = nullptr;
+};
+}
+
+// Log-linear (HDR style) histogram with fixed inline buckets. Every power of two is split into
+// SubBuckets linear buckets, so values are recorded with a relative error of 1 / SubBuckets
+// over the whole 64 bit range.
+// A histogram is only ever written by a single thread, so recording is a relaxed load and
+// store rather than an atomic increment. Other threads can read the buckets at any time.
+class LatencyHistogram : NonCopyable, NonMovable {
+public:
+    static constexpr unsigned SubBucketBits = 3;
+    static constexpr std::size_t SubBuckets = 1 << SubBucketBits;
+    static constexpr std::size_t BucketCount = (64 - SubBucketBits + 1) * SubBuckets;
+
+    // Aggregated copy of one or more histograms which can be queried
+    class Snapshot {
+    public:
+        std::uint64_t count() const noexcept {
+            return count_;
+        }
+
+        // Returns the value (in the recorded unit) below which the given fraction of the
+        // samples lie, eg. percentile(0.99) for p99. The value is the upper bound of the
+        // bucket the percentile falls in.
+        std::uint64_t percentile(double fraction) const noexcept {
+            if (count_ == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<std::uint64_t>(fraction * count_ + 0.5);
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BucketCount; i++) {
+                seen += buckets_[i];
+                if (seen >= rank && buckets_[i] != 0) {
+                    return upperBound(i);
+                }
+            }
+            return upperBound(BucketCount - 1);
+        }
+
+        std::uint64_t p50() const noexcept { return percentile(0.5); }
+        std::uint64_t p99() const noexcept { return percentile(0.99); }
+        std::uint64_t p999() const noexcept { return percentile(0.999); }
+
+        // Samples recorded between earlier and this snapshot of the same source, which is
+        // what periodic reporting wants since snapshots are cumulative.
+        Snapshot since(const Snapshot& earlier) const noexcept {
+            Snapshot delta;
+            for (std::size_t i = 0; i < BucketCount; i++) {
+                delta.buckets_[i] = buckets_[i] - earlier.buckets_[i];
+            }
+            delta.count_ = count_ - earlier.count_;
+            return delta;
+        }
+
+        void add(const LatencyHistogram& histogram) noexcept {
+            for (std::size_t i = 0; i < BucketCount; i++) {
+                const auto value = histogram.buckets_[i].load(std::memory_order_relaxed);
+                buckets_[i] += value;
+                count_ += value;
+            }
+        }
+
+    private:
+        std::array<std::uint64_t, BucketCount> buckets_{};
+        std::uint64_t count_ = 0;
+    };
+
+    LatencyHistogram() = default;
+
+    void record(std::uint64_t value) noexcept {
+        auto& bucket = buckets_[bucketFor(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t bucketFor(std::uint64_t value) noexcept {
+        if (value < SubBuckets) {
+            return value;
+        }
+        const auto shift = detail::MostSignificantBit(value) - SubBucketBits;
+        const auto subBucket = (value >> shift) & (SubBuckets - 1);
+        return (shift + 1) * SubBuckets + subBucket;
+    }
+
+    static constexpr std::uint64_t lowerBound(std::size_t bucket) noexcept {
+        if (bucket < SubBuckets) {
+            return bucket;
+        }
+        const auto shift = bucket / SubBuckets - 1;
+        return (SubBuckets + bucket % SubBuckets) << shift;
+    }
+
+    static constexpr std::uint64_t upperBound(std::size_t bucket) noexcept {
+        if (bucket < SubBuckets) {
+            return bucket;
+        }
+        const auto shift = bucket / SubBuckets - 1;
+        return lowerBound(bucket) + (std::uint64_t(1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, BucketCount> buckets_{};
+};
+
+// A named timing point, usually declared through SH_SCOPED_TIMER. Every thread which records
+// into the site gets its own histogram (see detail::PerThreadList), so recording never
+// contends and samples of threads that have exited are still part of the aggregate.
+// Sites are enumerated through forEach(), see detail::SiteRegistry.
+class TimerSite : public detail::SiteRegistry<TimerSite, 256> {
+public:
+    explicit TimerSite(std::string_view name)
+        : SiteRegistry("Too many timer sites"), name_(name), histograms_(index()) {
+        link();
+    }
+
+    // Histogram of the calling thread for this site
+    LatencyHistogram& local() {
+        return histograms_.local();
+    }
+
+    // Aggregates the histograms of all threads. Values are in clock ticks, see toNanoseconds().
+    LatencyHistogram::Snapshot snapshot() const {
+        LatencyHistogram::Snapshot snapshot;
+        histograms_.forEach([&](const LatencyHistogram& histogram) { snapshot.add(histogram); });
+        return snapshot;
+    }
+
+    // Converts a value from a snapshot into nanoseconds
+    static double toNanoseconds(std::uint64_t ticks) {
+        return ticks / detail::TimerTicksPerNanosecond();
+    }
+
+    std::string_view name() const noexcept {
+        return name_;
+    }
+
+private:
+    std::string_view name_;
+    detail::PerThreadList<LatencyHistogram, MaxSites> histograms_;
+};
+
+// Records the time between construction and destruction into the site's histogram of the
+// calling thread. Like StackGuard, this is meant for scope-based usage and compiles down to
+// two timestamp reads and a bucket increment.
+// Prefer SH_SCOPED_TIMER, which compiles out completely when SH_DISABLE_TIMERS is defined.
+class ScopedTimer : NonCopyable, NonMovable {
+public:
+    explicit ScopedTimer(TimerSite& site) : histogram_(site.local()), start_(detail::TimerTicks()) {}
+
+    ~ScopedTimer() {
+        histogram_.record(detail::TimerTicks() - start_);
+    }
+
+private:
+    LatencyHistogram& histogram_;
+    std::uint64_t start_;
+};
+}
+
+#define SH_TIMER_CONCAT_IMPL(a, b) a##b
+#define SH_TIMER_CONCAT(a, b) SH_TIMER_CONCAT_IMPL(a, b)
+
+#ifdef SH_DISABLE_TIMERS
+#define SH_SCOPED_TIMER(name)
+#else
+// Times the rest of the enclosing scope under the given name. Example :
+// void handleRequest() {
+//     SH_SCOPED_TIMER("handleRequest");
+//     ...
+// }
+#define SH_SCOPED_TIMER(name) \
+    static sh::TimerSite SH_TIMER_CONCAT(shTimerSite, __LINE__)(name); \
+    sh::ScopedTimer SH_TIMER_CONCAT(shScopedTimer, __LINE__)(SH_TIMER_CONCAT(shTimerSite, __LINE__))
+#endif
@@ -0,0 +1,176 @@
+//
+//  Signal.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "AllocationCounter.h"
+#include "Signal.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("[Signal] connect, emit and disconnect") {
+    sh::Signal<int> signal;
+    std::vector<std::string> calls;
+    REQUIRE(signal.empty());
+
+    auto first = signal.connect([&](int x) { calls.push_back("first " + std::to_string(x)); });
+    auto second = signal.connect([&, owned = std::make_unique<int>(2)](int x) {
+        calls.push_back("second " + std::to_string(x * *owned));
+    });
+    REQUIRE(signal.size() == 2);
+    REQUIRE(signal.connected(first));
+    REQUIRE(signal.connected(second));
+
+    signal.emit(1);
+    REQUIRE(calls == std::vector<std::string>{"first 1", "second 2"});
+
+    SECTION("Disconnect") {
+        REQUIRE(signal.disconnect(first));
+        REQUIRE_FALSE(signal.connected(first));
+        REQUIRE_FALSE(signal.disconnect(first));
+        calls.clear();
+        signal(3);
+        REQUIRE(calls == std::vector<std::string>{"second 6"});
+        REQUIRE(signal.size() == 1);
+    }
+
+    SECTION("Stale handles don't disconnect reused slots") {
+        signal.disconnect(first);
+        auto third = signal.connect([&](int) { calls.push_back("third"); });
+        REQUIRE(third.index == first.index);
+        REQUIRE_FALSE(signal.disconnect(first));
+        REQUIRE(signal.connected(third));
+        REQUIRE_FALSE(signal.disconnect(sh::Connection{}));
+    }
+}
+
+TEST_CASE("[Signal] slots returning a value") {
+    sh::Signal<int> signal;
+    int sum = 0;
+    signal.connect([&sum](int x) { return sum += x; });
+    signal.emit(2);
+    REQUIRE(sum == 2);
+}
+
+TEST_CASE("[Signal] spills over the inline capacity") {
+    sh::BasicSignal<2, int&> signal;
+    std::vector<sh::Connection> connections;
+    for (int i = 0; i < 10; i++) {
+        connections.push_back(signal.connect([i](int& sum) { sum += i; }));
+    }
+    int sum = 0;
+    signal.emit(sum);
+    REQUIRE(sum == 45);
+
+    // Disconnect from the inline part and the overflow
+    signal.disconnect(connections[0]);
+    signal.disconnect(connections[1]);
+    signal.disconnect(connections[9]);
+    sum = 0;
+    signal.emit(sum);
+    REQUIRE(sum == 45 - 1 - 9);
+    REQUIRE(signal.size() == 7);
+    for (std::size_t i = 2; i < 9; i++) {
+        REQUIRE(signal.connected(connections[i]));
+    }
+}
+
+TEST_CASE("[Signal] reentrancy") {
+    sh::Signal<> signal;
+    int calls = 0;
+
+    SECTION("Slots disconnecting themselves and others") {
+        sh::Connection self;
+        sh::Connection other;
+        self = signal.connect([&]() {
+            calls++;
+            signal.disconnect(self);
+            signal.disconnect(other);
+        });
+        other = signal.connect([&]() { calls += 100; });
+        signal.emit();
+        REQUIRE(calls == 1);
+        REQUIRE(signal.empty());
+        signal.emit();
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Slots connected during emission run from the next one") {
+        signal.connect([&]() {
+            calls++;
+            if (calls == 1) {
+                signal.connect([&]() { calls += 10; });
+            }
+        });
+        {
+            // Below the inline capacity, staging the new slot doesn't allocate
+            sh::AllocationCounter allocations;
+            signal.emit();
+            REQUIRE(allocations.count() == 0);
+        }
+        REQUIRE(calls == 1);
+        REQUIRE(signal.size() == 2);
+        signal.emit();
+        REQUIRE(calls == 12);
+    }
+
+    SECTION("Connect and disconnect during a nested emission") {
+        sh::Connection added;
+        bool nested = false;
+        signal.connect([&]() {
+            calls++;
+            if (!nested) {
+                nested = true;
+                signal.emit();
+                added = signal.connect([&]() { calls += 100; });
+                signal.disconnect(added);
+            }
+        });
+        signal.emit();
+        REQUIRE(calls == 2);
+        REQUIRE(signal.size() == 1);
+        REQUIRE_FALSE(signal.connected(added));
+        signal.emit();
+        REQUIRE(calls == 3);
+    }
+
+    SECTION("Exceptions end the emission") {
+        auto throwing = signal.connect([&]() { throw std::runtime_error("slot failed"); });
+        signal.connect([&]() {
+            calls++;
+        });
+        signal.connect([&]() {
+            signal.disconnect(throwing);
+        });
+        REQUIRE_THROWS_AS(signal.emit(), std::runtime_error);
+        // The signal isn't left in the emitting state
+        auto connection = signal.connect([&]() { calls += 10; });
+        REQUIRE(signal.connected(connection));
+        signal.disconnect(throwing);
+        signal.emit();
+        REQUIRE(calls == 11);
+    }
+
+    SECTION("Slots connected before an exception are kept") {
+        signal.connect([&]() {
+            if (calls++ == 0) {
+                for (int i = 0; i < 8; i++) {
+                    signal.connect([&]() { calls += 10; });
+                }
+                throw std::runtime_error("slot failed");
+            }
+        });
+        REQUIRE_THROWS_AS(signal.emit(), std::runtime_error);
+        REQUIRE(signal.size() == 9);
+        signal.emit();
+        REQUIRE(calls == 82);
+    }
+}
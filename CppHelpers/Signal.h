@@ -0,0 +1,272 @@
+//
+//  Signal.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ArrayVector.h"
+#include "Guard.h"
+#include "MoveOnlyFunction.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+// Handle to a slot connected to a Signal. Handles carry the generation of the slot they were
+// issued for, so disconnecting twice or after the slot index has been reused is harmless.
+struct Connection {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+};
+
+// Broadcasts calls to a dynamic set of slots, an alternative to std::vector<std::function>
+// with linear-scan removal and a copy of the vector on every emission.
+// Slots are MoveOnlyFunctions kept in a dense array which emission walks directly, handles
+// refer to them through a slot map (an index plus a generation), so disconnecting is O(1) : the
+// last slot is moved into the hole. Up to InlineSlots slots are stored inline (same as
+// Transaction, further slots spill over to the heap), so small signals don't allocate unless a
+// slot's captures don't fit in the MoveOnlyFunction buffer.
+// Slots may connect and disconnect (themselves or others) while the signal is emitting. Those
+// changes are deferred until the outermost emission returns : slots disconnected during an
+// emission are no longer called, slots connected during an emission are first called by the
+// next one. Those are staged in the same kind of storage, so connecting during an emission
+// doesn't allocate either while the signal stays within InlineSlots.
+// Example :
+// Signal<const Event&> onEvent;
+// auto connection = onEvent.connect([this](const Event& e) { handle(e); });
+// onEvent.emit(event);
+// onEvent.disconnect(connection);
+// Slots are called in connection order until the first disconnect, which reorders them.
+template <std::size_t InlineSlots, typename... Args>
+class BasicSignal : NonCopyable, NonMovable {
+public:
+    using Slot = MoveOnlyFunction<void(Args...)>;
+
+    BasicSignal() = default;
+
+    template <typename F, typename = std::enable_if_t<std::is_constructible_v<Slot, F>>>
+    Connection connect(F&& f) {
+        auto connection = allocateEntry();
+        if (emitting_ > 0) {
+            pending_.push_back({Slot{std::forward<F>(f)}, connection});
+            entries_[connection.index].dense = Pending;
+        } else {
+            entries_[connection.index].dense = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back({Slot{std::forward<F>(f)}, connection});
+        }
+        return connection;
+    }
+
+    // Returns false if the connection was already disconnected
+    bool disconnect(Connection connection) noexcept {
+        if (!connected(connection)) {
+            return false;
+        }
+        auto& entry = entries_[connection.index];
+        const auto dense = entry.dense;
+        // Invalidates the handle (and, during emission, marks the slot as dead)
+        entry.generation++;
+        entry.dense = freeHead_;
+        freeHead_ = connection.index;
+        size_--;
+
+        if (emitting_ > 0) {
+            dirty_ = true;
+        } else if (dense != Pending) {
+            removeAt(dense);
+        }
+        return true;
+    }
+
+    bool connected(Connection connection) const noexcept {
+        return connection.index < entries_.size() && entries_[connection.index].generation == connection.generation;
+    }
+
+    // Calls every connected slot, arguments are passed to each slot as lvalues
+    void emit(Args... args) {
+        emitting_++;
+        // Only runs if a slot throws. Merging the pending slots can allocate, which must not throw
+        // from a destructor (let alone during unwinding), so if that fails they stay pending until
+        // the next emission finishes.
+        ScopeFail guard([this]() noexcept {
+            if (--emitting_ == 0) {
+                try {
+                    applyDeferred();
+                } catch (...) {
+                }
+            }
+        });
+        // Slots connected during the emission are deferred, so the size can't grow
+        const auto count = slots_.size();
+        for (std::size_t i = 0; i < count; i++) {
+            auto& slot = slots_[i];
+            if (isLive(slot)) {
+                slot.function(args...);
+            }
+        }
+        guard.dismiss();
+        if (--emitting_ == 0) {
+            applyDeferred();
+        }
+    }
+
+    void operator()(Args... args) {
+        emit(std::forward<Args>(args)...);
+    }
+
+    // Number of connected slots
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+private:
+    static constexpr std::uint32_t Pending = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t NoFree = std::numeric_limits<std::uint32_t>::max();
+
+    struct SlotData {
+        Slot function;
+        Connection connection;
+    };
+
+    // Slot map entry. For connected slots dense is the position in slots_ (or Pending), for
+    // free entries it links the free list.
+    struct Entry {
+        std::uint32_t generation;
+        std::uint32_t dense;
+    };
+
+    // Inline storage for the first InlineSlots elements, the heap for the rest
+    template <typename T>
+    class SpillVector {
+    public:
+        T& operator[](std::size_t i) noexcept {
+            return i < InlineSlots ? inline_[i] : overflow_[i - InlineSlots];
+        }
+
+        const T& operator[](std::size_t i) const noexcept {
+            return i < InlineSlots ? inline_[i] : overflow_[i - InlineSlots];
+        }
+
+        void push_back(T&& value) {
+            if (inline_.size() < inline_.capacity()) {
+                inline_.push_back(std::move(value));
+            } else {
+                overflow_.push_back(std::move(value));
+            }
+        }
+
+        // Makes sure that pushing up to size elements doesn't allocate. Grows like push_back,
+        // reserving the exact size every time would make repeated calls quadratic.
+        void reserve(std::size_t size) {
+            if (size > InlineSlots + overflow_.capacity()) {
+                overflow_.reserve(std::max(size - InlineSlots, 2 * overflow_.capacity()));
+            }
+        }
+
+        void pop_back() noexcept {
+            if (!overflow_.empty()) {
+                overflow_.pop_back();
+            } else {
+                inline_.pop_back();
+            }
+        }
+
+        std::size_t size() const noexcept {
+            return inline_.size() + overflow_.size();
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // Keeps the heap storage for reuse
+        void clear() noexcept {
+            inline_.clear();
+            overflow_.clear();
+        }
+
+    private:
+        ArrayVector<T, InlineSlots> inline_;
+        std::vector<T> overflow_;
+    };
+
+    bool isLive(const SlotData& slot) const noexcept {
+        return entries_[slot.connection.index].generation == slot.connection.generation;
+    }
+
+    Connection allocateEntry() {
+        size_++;
+        if (freeHead_ != NoFree) {
+            auto index = freeHead_;
+            freeHead_ = entries_[index].dense;
+            return {index, entries_[index].generation};
+        }
+        entries_.push_back({0, Pending});
+        return {static_cast<std::uint32_t>(entries_.size() - 1), 0};
+    }
+
+    // Moves the last slot into the hole at position i
+    void removeAt(std::size_t i) noexcept {
+        const auto last = slots_.size() - 1;
+        if (i != last) {
+            slots_[i] = std::move(slots_[last]);
+            entries_[slots_[i].connection.index].dense = static_cast<std::uint32_t>(i);
+        }
+        slots_.pop_back();
+    }
+
+    // Removes the slots disconnected during emission and adds the ones connected during it. If
+    // making room for them throws, the pending slots are kept for the next call.
+    void applyDeferred() {
+        if (dirty_) {
+            dirty_ = false;
+            for (std::size_t i = slots_.size(); i-- > 0;) {
+                if (!isLive(slots_[i])) {
+                    removeAt(i);
+                }
+            }
+        }
+        if (pending_.empty()) {
+            return;
+        }
+        slots_.reserve(slots_.size() + pending_.size());
+        for (std::size_t i = 0; i < pending_.size(); i++) {
+            auto& pending = pending_[i];
+            if (connected(pending.connection)) {
+                entries_[pending.connection.index].dense = static_cast<std::uint32_t>(slots_.size());
+                slots_.push_back(std::move(pending));
+            }
+        }
+        pending_.clear();
+    }
+
+    SpillVector<SlotData> slots_;
+    SpillVector<Entry> entries_;
+    std::uint32_t freeHead_ = NoFree;
+    std::size_t size_ = 0;
+
+    // Reentrancy, connections made during emission wait here until it returns
+    std::uint32_t emitting_ = 0;
+    bool dirty_ = false;
+    SpillVector<SlotData> pending_;
+};
+
+template <typename... Args>
+using Signal = BasicSignal<4, Args...>;
+}
@@ -0,0 +1,58 @@
+//
+//  TEContainer.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "TEContainer.h"
+
+#include <any>
+#include <array>
+
+namespace {
+// Too large for the libstdc++ std::any buffer (a single pointer), small enough for TEContainer
+struct Medium {
+    std::array<int, 6> values;
+};
+}
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+TEST_CASE("Type-erased value vs std::any", "[!benchmark][TEContainer]") {
+    const Medium medium{{1, 2, 3, 4, 5, 6}};
+
+    BENCHMARK("TEContainer construct + destroy") {
+        sh::TEContainer<> value = medium;
+        return sh::any_cast<Medium>(&value)->values[0];
+    };
+
+    BENCHMARK("std::any construct + destroy") {
+        std::any value = medium;
+        return std::any_cast<Medium>(&value)->values[0];
+    };
+
+    sh::TEContainer<> teValue = medium;
+    std::any anyValue = medium;
+
+    BENCHMARK("TEContainer copy") {
+        auto copy = teValue;
+        return sh::any_cast<Medium>(&copy)->values[5];
+    };
+
+    BENCHMARK("std::any copy") {
+        auto copy = anyValue;
+        return std::any_cast<Medium>(&copy)->values[5];
+    };
+
+    BENCHMARK("TEContainer any_cast") {
+        return sh::any_cast<Medium>(&teValue)->values[1];
+    };
+
+    BENCHMARK("std::any any_cast") {
+        return std::any_cast<Medium>(&anyValue)->values[1];
+    };
+}
@@ -0,0 +1,168 @@
+//
+//  TEContainer.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "TEContainer.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+struct Counter {
+    static inline int alive = 0;
+    Counter() { alive++; }
+    Counter(const Counter&) { alive++; }
+    Counter(Counter&&) noexcept { alive++; }
+    ~Counter() { alive--; }
+};
+
+using Large = std::array<char, 64>;
+
+// Same layout and trivial members, their managers only differ by the type tag
+struct Meters {
+    int value;
+};
+
+struct Seconds {
+    int value;
+};
+}
+
+TEST_CASE("[TEContainer] static asserts") {
+    using Container = sh::TEContainer<>;
+    using MoveOnly = sh::TEContainer<24, alignof(std::max_align_t), false>;
+    static_assert(std::is_copy_constructible_v<Container>);
+    static_assert(std::is_nothrow_move_constructible_v<Container>);
+    static_assert(!std::is_copy_constructible_v<MoveOnly>);
+    static_assert(!std::is_copy_assignable_v<MoveOnly>);
+    static_assert(std::is_nothrow_move_constructible_v<MoveOnly>);
+    static_assert(Container::storedInline<int>());
+    static_assert(Container::storedInline<std::string>());
+    static_assert(!Container::storedInline<Large>());
+    // One pointer for the manager table on top of the buffer
+    static_assert(sizeof(sh::TEContainer<16, alignof(void*)>) == 3 * sizeof(void*));
+}
+
+TEST_CASE("[TEContainer] stores values") {
+    sh::TEContainer<> container;
+    REQUIRE_FALSE(container.hasValue());
+
+    SECTION("Inline values") {
+        container = 42;
+        REQUIRE(container.hasValue());
+        REQUIRE(container.holds<int>());
+        REQUIRE_FALSE(container.holds<long>());
+        REQUIRE(sh::any_cast<int>(container) == 42);
+        REQUIRE(sh::any_cast<long>(&container) == nullptr);
+        REQUIRE_THROWS_AS(sh::any_cast<long>(container), std::bad_any_cast);
+        sh::any_cast<int&>(container) = 7;
+        REQUIRE(*sh::any_cast<int>(&container) == 7);
+    }
+
+    SECTION("Heap values") {
+        Large large{};
+        large[63] = 'x';
+        container = large;
+        REQUIRE(container.holds<Large>());
+        REQUIRE(sh::any_cast<const Large&>(container)[63] == 'x');
+    }
+
+    SECTION("Emplace and reset") {
+        auto& str = container.emplace<std::string>(3, 'a');
+        REQUIRE(str == "aaa");
+        container.reset();
+        REQUIRE_FALSE(container.hasValue());
+        REQUIRE(sh::any_cast<std::string>(&container) == nullptr);
+    }
+}
+
+TEST_CASE("[TEContainer] copy and move") {
+    Counter::alive = 0;
+
+    SECTION("Copies are independent") {
+        sh::TEContainer<> first = std::string("text");
+        auto second = first;
+        sh::any_cast<std::string&>(second) += "!";
+        REQUIRE(sh::any_cast<std::string>(first) == "text");
+        REQUIRE(sh::any_cast<std::string>(second) == "text!");
+
+        sh::TEContainer<> large = Large{};
+        first = large;
+        REQUIRE(first.holds<Large>());
+        REQUIRE(sh::any_cast<Large>(&first) != sh::any_cast<Large>(&large));
+    }
+
+    SECTION("Moving empties the source") {
+        {
+            sh::TEContainer<> first = Counter{};
+            REQUIRE(Counter::alive == 1);
+            auto second = std::move(first);
+            REQUIRE_FALSE(first.hasValue());
+            REQUIRE(second.holds<Counter>());
+            REQUIRE(Counter::alive == 1);
+        }
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Heap values are moved by pointer") {
+        sh::TEContainer<> first = Large{};
+        auto address = sh::any_cast<Large>(&first);
+        sh::TEContainer<> second;
+        second = std::move(first);
+        REQUIRE(sh::any_cast<Large>(&second) == address);
+    }
+
+    SECTION("Move-only containers hold move-only types") {
+        sh::TEContainer<16, alignof(std::max_align_t), false> first = std::make_unique<int>(5);
+        auto second = std::move(first);
+        REQUIRE(*sh::any_cast<std::unique_ptr<int>&>(second) == 5);
+        auto value = sh::any_cast<std::unique_ptr<int>>(std::move(second));
+        REQUIRE(*value == 5);
+    }
+}
+
+TEST_CASE("[TEContainer] replacing a value with a copy of itself") {
+    SECTION("Inline values") {
+        sh::TEContainer<> container = std::string("text");
+        container = *container.get<std::string>();
+        REQUIRE(sh::any_cast<std::string>(container) == "text");
+        container.emplace<std::string>(*container.get<std::string>() + "!");
+        REQUIRE(sh::any_cast<std::string>(container) == "text!");
+    }
+
+    SECTION("Heap values") {
+        Large large{};
+        large[63] = 'x';
+        sh::TEContainer<> container = large;
+        container = *container.get<Large>();
+        REQUIRE(sh::any_cast<Large&>(container)[63] == 'x');
+        container.emplace<Large>(*container.get<Large>());
+        REQUIRE(sh::any_cast<Large&>(container)[63] == 'x');
+    }
+
+    SECTION("Containers holding containers") {
+        sh::TEContainer<> outer;
+        outer.emplace<sh::TEContainer<>>(std::string("inner"));
+        outer = *outer.get<sh::TEContainer<>>();
+        REQUIRE(sh::any_cast<std::string>(outer) == "inner");
+
+        outer.emplace<sh::TEContainer<>>(std::string("moved"));
+        outer = std::move(*outer.get<sh::TEContainer<>>());
+        REQUIRE(sh::any_cast<std::string>(outer) == "moved");
+    }
+}
+
+TEST_CASE("[TEContainer] types with identical managers are distinct") {
+    sh::TEContainer<> container = Meters{3};
+    REQUIRE(container.holds<Meters>());
+    REQUIRE_FALSE(container.holds<Seconds>());
+    REQUIRE(sh::any_cast<Seconds>(&container) == nullptr);
+}
@@ -8,15 +8,294 @@
 
 #pragma once
 
+#include <any>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace sh {
-// TEContainer acts as a type-erased container for arbitrary data.
-// This implementation allows for small buffer optimization ...
-class TEContainer {
-    
-    // copyable
-    // movable
-    // move-only behavior
-    // small buffer on stack, larger allocations on heap
-    
+namespace detail {
+// Base classes which make the defaulted special members of TEContainer copyable or move-only
+struct CopyableTag {};
+
+struct MoveOnlyTag {
+    MoveOnlyTag() = default;
+    MoveOnlyTag(const MoveOnlyTag&) = delete;
+    MoveOnlyTag(MoveOnlyTag&&) = default;
+    MoveOnlyTag& operator=(const MoveOnlyTag&) = delete;
+    MoveOnlyTag& operator=(MoveOnlyTag&&) = default;
 };
+
+// Its address identifies the stored type. It is deliberately not const : identical code folding
+// may merge identical constant data (eg. the managers of two types whose functions were folded),
+// but never two writable objects.
+template <typename T>
+inline char TEContainerTypeTag = 0;
+}
+
+// TEContainer acts as a type-erased container for arbitrary data, like std::any.
+// This implementation allows for small buffer optimization : values up to BufferBytes (and
+// Alignment) which are nothrow movable are stored inline, anything else is heap allocated.
+// The default buffer fits std::string and std::function on the common standard libraries.
+// The container is copyable if Copyable is set (in which case every stored type must be copy
+// constructible), otherwise it is move-only and can hold move-only types.
+// Like Guard, the stored type is only remembered through a static table of function pointers
+// (one per stored type), so there are no vtables involved. The table points at a per-type tag
+// whose address is the type's identity, which means any_cast doesn't need RTTI.
+// Example :
+// TEContainer<> value = std::string("text");
+// if (auto str = any_cast<std::string>(&value)) {
+//     ...
+// }
+template <std::size_t BufferBytes = 4 * sizeof(void*), std::size_t Alignment = alignof(std::max_align_t),
+          bool Copyable = true>
+class TEContainer : std::conditional_t<Copyable, detail::CopyableTag, detail::MoveOnlyTag> {
+public:
+    static_assert(BufferBytes >= sizeof(void*), "The buffer must be able to hold a pointer");
+
+    constexpr TEContainer() noexcept = default;
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, TEContainer>>>
+    TEContainer(T&& value) {
+        emplace<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    // Copy operations are deleted if Copyable isn't set, see the base class
+    TEContainer(const TEContainer&) = default;
+    TEContainer(TEContainer&&) noexcept = default;
+    TEContainer& operator=(const TEContainer&) = default;
+    TEContainer& operator=(TEContainer&&) noexcept = default;
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, TEContainer>>>
+    TEContainer& operator=(T&& value) {
+        emplace<std::decay_t<T>>(std::forward<T>(value));
+        return *this;
+    }
+
+    // Constructs a T and replaces the current value (if any) with it. The T is constructed
+    // before the current value is destroyed, so args may refer to the current value, eg.
+    // c.emplace<T>(*c.get<T>()). If the constructor throws, the current value is kept.
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(std::is_same_v<T, std::decay_t<T>>, "Cannot store references or arrays");
+        static_assert(!Copyable || std::is_copy_constructible_v<T>, "Copyable containers need copyable types");
+        T* value;
+        if constexpr (Handler<T>::Inline) {
+            if (hasValue()) {
+                // The buffer is still in use, build the value aside and move it in (nothrow)
+                T temporary(std::forward<Args>(args)...);
+                reset();
+                value = new (&storage_.buffer) T(std::move(temporary));
+            } else {
+                value = new (&storage_.buffer) T(std::forward<Args>(args)...);
+            }
+        } else {
+            value = new T(std::forward<Args>(args)...);
+            reset();
+            storage_.heap() = value;
+        }
+        storage_.manager = &Handler<T>::table;
+        return *value;
+    }
+
+    void reset() noexcept {
+        storage_.reset();
+    }
+
+    bool hasValue() const noexcept {
+        return storage_.manager != nullptr;
+    }
+
+    template <typename T>
+    bool holds() const noexcept {
+        return storage_.manager && storage_.manager->type == &detail::TEContainerTypeTag<T>;
+    }
+
+    // Whether values of type T are stored in the inline buffer
+    template <typename T>
+    static constexpr bool storedInline() noexcept {
+        return Handler<T>::Inline;
+    }
+
+    // Returns a pointer to the stored value if it is a T, nullptr otherwise
+    template <typename T>
+    T* get() noexcept {
+        return holds<T>() ? static_cast<T*>(storage_.value()) : nullptr;
+    }
+
+    template <typename T>
+    const T* get() const noexcept {
+        return holds<T>() ? static_cast<const T*>(storage_.value()) : nullptr;
+    }
+
+private:
+    // One per stored type, see Handler
+    struct Manager {
+        const char* type;
+        bool isInline;
+        void (*destroy)(void* value) noexcept;
+        // Only used for inline values, heap values are moved by moving the pointer
+        void (*move)(void* from, void* to) noexcept;
+        void (*copy)(const void* from, void* to);
+    };
+
+    template <typename T>
+    struct Handler {
+        static constexpr bool Inline = sizeof(T) <= BufferBytes && alignof(T) <= Alignment &&
+                                       std::is_nothrow_move_constructible_v<T>;
+
+        static void destroy(void* value) noexcept {
+            if constexpr (Inline) {
+                static_cast<T*>(value)->~T();
+            } else {
+                delete static_cast<T*>(value);
+            }
+        }
+
+        static void move(void* from, void* to) noexcept {
+            if constexpr (Inline) {
+                auto& source = *static_cast<T*>(from);
+                new (to) T(std::move(source));
+                source.~T();
+            }
+        }
+
+        // to is the destination buffer, from is the source value
+        static void copy(const void* from, void* to) {
+            if constexpr (Copyable) {
+                const auto& source = *static_cast<const T*>(from);
+                if constexpr (Inline) {
+                    new (to) T(source);
+                } else {
+                    *static_cast<void**>(to) = new T(source);
+                }
+            }
+        }
+
+        static constexpr Manager table{&detail::TEContainerTypeTag<T>, Inline, &destroy, &move, &copy};
+    };
+
+    // Owns the value, the special members of TEContainer are defaulted on top of this
+    struct Storage {
+        Storage() noexcept = default;
+
+        Storage(const Storage& other) {
+            copyFrom(other);
+        }
+
+        Storage(Storage&& other) noexcept {
+            moveFrom(other);
+        }
+
+        // The source is copied (or taken over) before the current value is destroyed, since it
+        // may be owned by it, eg. a container holding a container. Exception safety: if copying
+        // throws, *this is unchanged.
+        Storage& operator=(const Storage& other) {
+            if (this != &other) {
+                Storage copy(other);
+                reset();
+                moveFrom(copy);
+            }
+            return *this;
+        }
+
+        Storage& operator=(Storage&& other) noexcept {
+            if (this != &other) {
+                Storage source(std::move(other));
+                reset();
+                moveFrom(source);
+            }
+            return *this;
+        }
+
+        ~Storage() {
+            reset();
+        }
+
+        void reset() noexcept {
+            if (manager) {
+                manager->destroy(value());
+                manager = nullptr;
+            }
+        }
+
+        void copyFrom(const Storage& other) {
+            if (other.manager) {
+                other.manager->copy(other.value(), &buffer);
+                manager = other.manager;
+            }
+        }
+
+        void moveFrom(Storage& other) noexcept {
+            if (other.manager) {
+                if (other.manager->isInline) {
+                    other.manager->move(&other.buffer, &buffer);
+                } else {
+                    heap() = other.heap();
+                }
+                manager = std::exchange(other.manager, nullptr);
+            }
+        }
+
+        void* value() const noexcept {
+            return manager->isInline ? const_cast<void*>(static_cast<const void*>(&buffer)) : heap();
+        }
+
+        void*& heap() noexcept {
+            return *reinterpret_cast<void**>(&buffer);
+        }
+
+        void* heap() const noexcept {
+            return *reinterpret_cast<void* const*>(&buffer);
+        }
+
+        const Manager* manager = nullptr;
+        std::aligned_storage_t<BufferBytes, Alignment> buffer;
+    };
+
+    Storage storage_;
+};
+
+// Same semantics as std::any_cast, without RTTI. The pointer versions return nullptr if the
+// container doesn't hold a T, the reference versions throw std::bad_any_cast.
+template <typename T, std::size_t B, std::size_t A, bool C>
+T* any_cast(TEContainer<B, A, C>* container) noexcept {
+    return container ? container->template get<T>() : nullptr;
+}
+
+template <typename T, std::size_t B, std::size_t A, bool C>
+const T* any_cast(const TEContainer<B, A, C>* container) noexcept {
+    return container ? container->template get<T>() : nullptr;
+}
+
+template <typename T, std::size_t B, std::size_t A, bool C>
+T any_cast(TEContainer<B, A, C>& container) {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    auto value = container.template get<U>();
+    if (!value) {
+        throw std::bad_any_cast();
+    }
+    return static_cast<T>(*value);
+}
+
+template <typename T, std::size_t B, std::size_t A, bool C>
+T any_cast(const TEContainer<B, A, C>& container) {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    auto value = container.template get<U>();
+    if (!value) {
+        throw std::bad_any_cast();
+    }
+    return static_cast<T>(*value);
+}
+
+template <typename T, std::size_t B, std::size_t A, bool C>
+T any_cast(TEContainer<B, A, C>&& container) {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    auto value = container.template get<U>();
+    if (!value) {
+        throw std::bad_any_cast();
+    }
+    return static_cast<T>(std::move(*value));
+}
 }
@@ -0,0 +1,191 @@
+//
+//  TEVector.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "TEVector.h"
+#include "Variant.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct Add {
+    int value;
+    void operator()(std::vector<int>& log) { log.push_back(value); }
+};
+
+struct Append {
+    std::string text;
+    void operator()(std::vector<int>& log) { log.push_back(static_cast<int>(text.size())); }
+};
+
+// Returns something, which void signatures discard
+struct Count {
+    std::size_t operator()(std::vector<int>& log) {
+        log.push_back(static_cast<int>(log.size()));
+        return log.size();
+    }
+};
+
+struct alignas(16) Aligned {
+    double values[2];
+    void operator()(std::vector<int>& log) { log.push_back(-1); }
+};
+
+struct Counter {
+    static inline int alive = 0;
+    static inline int moves = 0;
+    Counter() { alive++; }
+    Counter(Counter&&) noexcept { alive++; moves++; }
+    ~Counter() { alive--; }
+};
+
+struct Faulty {
+    Faulty() { throw std::runtime_error("construction failed"); }
+};
+}
+
+TEST_CASE("[TEVector] stores heterogeneous entries") {
+    sh::TEVector<void(std::vector<int>&)> commands;
+    REQUIRE(commands.empty());
+    REQUIRE(commands.begin() == commands.end());
+
+    commands.emplace_back<Add>(Add{1});
+    commands.push_back(Append{"four"});
+    commands.emplace_back<Aligned>();
+    commands.push_back(Add{2});
+    REQUIRE(commands.size() == 4);
+
+    SECTION("Invoke in order") {
+        std::vector<int> log;
+        for (auto command : commands) {
+            command(log);
+        }
+        REQUIRE(log == std::vector<int>{1, 4, -1, 2});
+    }
+
+    SECTION("Entries returning a value") {
+        commands.push_back(Count{});
+        std::vector<int> log;
+        for (auto command : commands) {
+            command(log);
+        }
+        REQUIRE(log == std::vector<int>{1, 4, -1, 2, 4});
+    }
+
+    SECTION("Typed access and visit") {
+        int adds = 0;
+        int appends = 0;
+        int unknown = 0;
+        for (auto entry : commands) {
+            bool known = entry.visit<Add, Append>(sh::Overloaded{
+                [&](Add& add) { adds += add.value; },
+                [&](Append&) { appends++; },
+            });
+            unknown += !known;
+            if (auto aligned = entry.get<Aligned>()) {
+                REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 16 == 0);
+            }
+        }
+        REQUIRE(adds == 3);
+        REQUIRE(appends == 1);
+        REQUIRE(unknown == 1);
+
+        const auto& constCommands = commands;
+        auto first = *constCommands.begin();
+        REQUIRE(first.holds<Add>());
+        REQUIRE_FALSE(first.holds<Append>());
+        REQUIRE(first.get<Append>() == nullptr);
+        static_assert(std::is_same_v<decltype(first.get<Add>()), const Add*>);
+    }
+
+    SECTION("Growing keeps the entries") {
+        for (int i = 0; i < 100; i++) {
+            commands.push_back(Append{std::string(i, 'x')});
+        }
+        std::vector<int> log;
+        for (auto command : commands) {
+            command(log);
+        }
+        REQUIRE(log.size() == 104);
+        REQUIRE(log[3] == 2);
+        REQUIRE(log[103] == 99);
+    }
+}
+
+TEST_CASE("[TEVector] lifetime") {
+    Counter::alive = 0;
+    Counter::moves = 0;
+
+    SECTION("Non-relocatable entries are moved on growth") {
+        {
+            sh::TEVector<> values;
+            values.emplace_back<Counter>();
+            auto capacity = values.capacity();
+            while (values.capacity() == capacity) {
+                values.emplace_back<int>(0);
+            }
+            REQUIRE(Counter::alive == 1);
+            REQUIRE(Counter::moves == 1);
+        }
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Arguments may refer to an entry when growing") {
+        sh::TEVector<> values;
+        values.emplace_back<std::string>(64, 's');
+        auto capacity = values.capacity();
+        while (values.capacity() == capacity) {
+            values.emplace_back<std::string>(*(*values.begin()).get<std::string>());
+        }
+        for (auto value : values) {
+            REQUIRE(*value.get<std::string>() == std::string(64, 's'));
+        }
+    }
+
+    SECTION("Throwing constructors leave the vector unchanged") {
+        sh::TEVector<> values;
+        values.emplace_back<Counter>();
+        // Fill up the buffer, so that the failing entry needs a bigger one
+        while (values.bytes() + 2 * sizeof(void*) <= values.capacity()) {
+            values.emplace_back<int>(0);
+        }
+        auto size = values.size();
+        auto bytes = values.bytes();
+        auto capacity = values.capacity();
+        REQUIRE_THROWS_AS(values.emplace_back<Faulty>(), std::runtime_error);
+        REQUIRE(values.size() == size);
+        REQUIRE(values.bytes() == bytes);
+        REQUIRE(values.capacity() == capacity);
+        REQUIRE(Counter::alive == 1);
+        REQUIRE(Counter::moves == 0);
+    }
+
+    SECTION("Trivially relocatable entries are memcpy'd") {
+        sh::TEVector<> values;
+        values.emplace_back<int>(7);
+        values.reserve(values.capacity() * 4);
+        REQUIRE(*(*values.begin()).get<int>() == 7);
+    }
+
+    SECTION("Move and clear") {
+        sh::TEVector<> values;
+        values.emplace_back<Counter>();
+        values.emplace_back<std::unique_ptr<int>>(std::make_unique<int>(1));
+        auto other = std::move(values);
+        REQUIRE(values.empty());
+        REQUIRE(other.size() == 2);
+        REQUIRE(Counter::alive == 1);
+        other.clear();
+        REQUIRE(Counter::alive == 0);
+        REQUIRE(other.bytes() == 0);
+    }
+}
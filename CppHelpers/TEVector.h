@@ -0,0 +1,401 @@
+//
+//  TEVector.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Relocatable.h"
+
+namespace sh {
+namespace detail {
+// The call signature of TEVector entries, void for containers which only store objects
+template <typename Signature>
+struct TEVectorInvoker {
+    using Fn = std::nullptr_t;
+
+    template <typename T>
+    static constexpr bool IsInvocable = true;
+
+    template <typename T>
+    static constexpr Fn make() noexcept {
+        return nullptr;
+    }
+};
+
+template <typename R, typename... Args>
+struct TEVectorInvoker<R(Args...)> {
+    using Fn = R (*)(void*, Args...);
+
+    template <typename T>
+    static constexpr bool IsInvocable = std::is_invocable_r_v<R, T&, Args...>;
+
+    template <typename T>
+    static constexpr Fn make() noexcept {
+        return [](void* object, Args... args) -> R {
+            // Void signatures accept entries which return something, the result is discarded
+            if constexpr (std::is_void_v<R>) {
+                std::invoke(*static_cast<T*>(object), std::forward<Args>(args)...);
+            } else {
+                return std::invoke(*static_cast<T*>(object), std::forward<Args>(args)...);
+            }
+        };
+    }
+};
+
+// Its address identifies the stored type. Not const, like TEContainerTypeTag, so that identical
+// code folding can't merge the tags (or the tables holding them) of two types.
+template <typename T>
+inline char TEVectorTypeTag = 0;
+
+inline std::uintptr_t alignUp(std::uintptr_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}
+
+// Growable container of heterogeneous objects, packed back to back in a single byte buffer.
+// An alternative to std::vector<std::unique_ptr<Base>> which doesn't allocate per element,
+// keeps the elements contiguous and doesn't need a common base class.
+// Every entry is a one pointer header followed by the object, the header points at a static
+// table for the entry's type (like TEContainer) with its size, alignment, relocation,
+// destruction and, if Signature isn't void, a trampoline to call it :
+// TEVector<void(Context&)> commands;
+// commands.emplace_back<DrawCommand>(mesh);
+// commands.emplace_back<ClearCommand>(color);
+// for (auto command : commands) {
+//     command(context);
+// }
+// Types are checked when visiting an entry with a known list of types :
+// entry.visit<DrawCommand, ClearCommand>([](auto& command) { ... });
+// When the buffer grows, the entries keep their offsets in the new buffer. Trivially relocatable
+// entries (see Relocatable.h) are moved with a memcpy, and if every entry is, the whole buffer
+// is moved with a single memcpy.
+// Like std::vector, growing invalidates references and iterators.
+template <typename Signature = void>
+class TEVector {
+    using Invoker = detail::TEVectorInvoker<Signature>;
+
+    // One per stored type
+    struct Manager {
+        const char* type;
+        std::size_t size;
+        std::size_t alignment;
+        // Moves the object and destroys the source, nullptr if that is a memcpy
+        void (*relocate)(void* from, void* to) noexcept;
+        // nullptr for trivially destructible objects
+        void (*destroy)(void* object) noexcept;
+        typename Invoker::Fn invoke;
+    };
+
+    template <typename T>
+    struct Handler {
+        static void relocate(void* from, void* to) noexcept {
+            auto& source = *static_cast<T*>(from);
+            new (to) T(std::move(source));
+            source.~T();
+        }
+
+        static void destroy(void* object) noexcept {
+            static_cast<T*>(object)->~T();
+        }
+
+        static constexpr Manager table{
+            &detail::TEVectorTypeTag<T>,
+            sizeof(T),
+            alignof(T),
+            IsTriviallyRelocatable_v<T> ? nullptr : &relocate,
+            std::is_trivially_destructible_v<T> ? nullptr : &destroy,
+            Invoker::template make<T>(),
+        };
+    };
+
+    struct Header {
+        const Manager* manager;
+    };
+
+    // Entries start at offsets aligned for the header, and the buffer is aligned for any type
+    static constexpr std::size_t BufferAlignment = alignof(std::max_align_t);
+
+    static std::byte* objectFor(std::byte* header) noexcept {
+        auto manager = reinterpret_cast<Header*>(header)->manager;
+        auto address = reinterpret_cast<std::uintptr_t>(header + sizeof(Header));
+        return reinterpret_cast<std::byte*>(detail::alignUp(address, manager->alignment));
+    }
+
+    static std::byte* nextAfter(std::byte* header) noexcept {
+        auto manager = reinterpret_cast<Header*>(header)->manager;
+        auto end = reinterpret_cast<std::uintptr_t>(objectFor(header) + manager->size);
+        return reinterpret_cast<std::byte*>(detail::alignUp(end, alignof(Header)));
+    }
+
+public:
+    // A reference to an entry, as returned by the iterators
+    template <bool Const>
+    class EntryRef {
+    public:
+        template <typename T>
+        bool holds() const noexcept {
+            return manager()->type == &detail::TEVectorTypeTag<T>;
+        }
+
+        // Returns a pointer to the object if it is a T, nullptr otherwise
+        template <typename T>
+        auto get() const noexcept {
+            using Pointer = std::conditional_t<Const, const T*, T*>;
+            return holds<T>() ? reinterpret_cast<Pointer>(objectFor(header_)) : nullptr;
+        }
+
+        // Calls visitor with the object if its type is one of Ts, and returns whether it was
+        template <typename... Ts, typename Visitor>
+        bool visit(Visitor&& visitor) const {
+            return ((holds<Ts>() ? (std::invoke(visitor, *get<Ts>()), true) : false) || ...);
+        }
+
+        // Calls the entry with the container's signature, only for mutable entries
+        template <typename... Args, typename S = Signature, typename = std::enable_if_t<!std::is_void_v<S> && !Const>>
+        decltype(auto) operator()(Args&&... args) const {
+            return manager()->invoke(objectFor(header_), std::forward<Args>(args)...);
+        }
+
+    private:
+        friend class TEVector;
+
+        explicit EntryRef(std::byte* header) noexcept : header_(header) {}
+
+        const Manager* manager() const noexcept {
+            return reinterpret_cast<const Header*>(header_)->manager;
+        }
+
+        std::byte* header_;
+    };
+
+    using Entry = EntryRef<false>;
+    using ConstEntry = EntryRef<true>;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EntryRef<Const>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = EntryRef<Const>;
+
+        Iterator() noexcept = default;
+
+        reference operator*() const noexcept {
+            return EntryRef<Const>(header_);
+        }
+
+        Iterator& operator++() noexcept {
+            header_ = nextAfter(header_);
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const Iterator& l, const Iterator& r) noexcept {
+            return l.header_ == r.header_;
+        }
+
+        friend bool operator!=(const Iterator& l, const Iterator& r) noexcept {
+            return l.header_ != r.header_;
+        }
+
+    private:
+        friend class TEVector;
+
+        explicit Iterator(std::byte* header) noexcept : header_(header) {}
+
+        std::byte* header_ = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    TEVector() noexcept = default;
+
+    TEVector(const TEVector&) = delete;
+    TEVector& operator=(const TEVector&) = delete;
+
+    TEVector(TEVector&& other) noexcept
+        : buffer_(std::exchange(other.buffer_, nullptr)),
+          used_(std::exchange(other.used_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          nonTrivialEntries_(std::exchange(other.nonTrivialEntries_, 0)) {}
+
+    TEVector& operator=(TEVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            deallocate(buffer_);
+            buffer_ = std::exchange(other.buffer_, nullptr);
+            used_ = std::exchange(other.used_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            nonTrivialEntries_ = std::exchange(other.nonTrivialEntries_, 0);
+        }
+        return *this;
+    }
+
+    ~TEVector() {
+        clear();
+        deallocate(buffer_);
+    }
+
+    // Exception safety: if the constructor throws, the vector is unchanged
+    template <typename T, typename... Args>
+    T& emplace_back(Args&&... args) {
+        static_assert(std::is_same_v<T, std::decay_t<T>>, "Cannot store references or arrays");
+        static_assert(alignof(T) <= BufferAlignment, "Over-aligned types aren't supported");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "Entries must be nothrow movable");
+        static_assert(Invoker::template IsInvocable<T>, "Entries must be callable with the container's signature");
+
+        auto objectOffset = detail::alignUp(used_ + sizeof(Header), alignof(T));
+        auto end = detail::alignUp(objectOffset + sizeof(T), alignof(Header));
+        T* object;
+        if (end <= capacity_) {
+            object = new (buffer_ + objectOffset) T(std::forward<Args>(args)...);
+        } else {
+            // Construct into the new buffer before releasing the old one, since args may refer
+            // to an entry, eg. v.emplace_back<T>(*(*v.begin()).get<T>())
+            const auto capacity = std::max({end, 2 * capacity_, std::size_t(256)});
+            auto buffer = allocate(capacity);
+            try {
+                object = new (buffer + objectOffset) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(buffer);
+                throw;
+            }
+            moveTo(buffer, capacity);
+        }
+        new (buffer_ + used_) Header{&Handler<T>::table};
+        used_ = end;
+        size_++;
+        if (!IsTriviallyRelocatable_v<T>) {
+            nonTrivialEntries_++;
+        }
+        return *object;
+    }
+
+    template <typename T>
+    void push_back(T&& value) {
+        emplace_back<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    // Destroys every entry and keeps the buffer
+    void clear() noexcept {
+        for (auto it = begin(); it != end(); ++it) {
+            auto manager = reinterpret_cast<Header*>(it.header_)->manager;
+            if (manager->destroy) {
+                manager->destroy(objectFor(it.header_));
+            }
+        }
+        used_ = 0;
+        size_ = 0;
+        nonTrivialEntries_ = 0;
+    }
+
+    // Makes sure that entries totalling `bytes` (headers and padding included) fit without
+    // growing
+    void reserve(std::size_t bytes) {
+        if (bytes > capacity_) {
+            reallocate(bytes);
+        }
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Bytes used by the entries, headers and padding included
+    std::size_t bytes() const noexcept {
+        return used_;
+    }
+
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    iterator begin() noexcept {
+        return iterator(buffer_);
+    }
+
+    iterator end() noexcept {
+        return iterator(buffer_ + used_);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(buffer_);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(buffer_ + used_);
+    }
+
+private:
+    void reallocate(std::size_t newCapacity) {
+        moveTo(allocate(newCapacity), newCapacity);
+    }
+
+    // Relocates the entries into buffer and releases the current one
+    void moveTo(std::byte* buffer, std::size_t newCapacity) noexcept {
+        if (nonTrivialEntries_ == 0) {
+            if (used_ > 0) {
+                std::memcpy(buffer, buffer_, used_);
+            }
+        } else {
+            // Both buffers have the same alignment, so every entry keeps its offset
+            for (auto header = buffer_; header != buffer_ + used_; header = nextAfter(header)) {
+                auto manager = reinterpret_cast<Header*>(header)->manager;
+                auto offset = header - buffer_;
+                auto objectOffset = objectFor(header) - buffer_;
+                new (buffer + offset) Header{manager};
+                if (manager->relocate) {
+                    manager->relocate(buffer_ + objectOffset, buffer + objectOffset);
+                } else {
+                    std::memcpy(buffer + objectOffset, buffer_ + objectOffset, manager->size);
+                }
+            }
+        }
+        deallocate(buffer_);
+        buffer_ = buffer;
+        capacity_ = newCapacity;
+    }
+
+    static std::byte* allocate(std::size_t capacity) {
+        return static_cast<std::byte*>(::operator new(capacity, std::align_val_t{BufferAlignment}));
+    }
+
+    static void deallocate(std::byte* buffer) noexcept {
+        ::operator delete(buffer, std::align_val_t{BufferAlignment});
+    }
+
+    std::byte* buffer_ = nullptr;
+    std::size_t used_ = 0;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+    std::size_t nonTrivialEntries_ = 0;
+};
+}
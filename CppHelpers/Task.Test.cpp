@@ -0,0 +1,109 @@
+//
+//  Task.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "Task.h"
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace {
+struct Counter {
+    static inline int alive = 0;
+    static inline int moves = 0;
+    Counter() { alive++; }
+    Counter(Counter&&) noexcept { alive++; moves++; }
+    ~Counter() { alive--; }
+};
+}
+
+TEST_CASE("[Task] static asserts") {
+    static_assert(sizeof(sh::Task) == 64);
+    static_assert(alignof(sh::Task) == 64);
+    static_assert(!std::is_copy_constructible_v<sh::Task>);
+    static_assert(std::is_nothrow_move_constructible_v<sh::Task>);
+    static_assert(sh::Task::StoredInline<std::array<char, 48>>);
+    static_assert(!sh::Task::StoredInline<std::array<char, 49>>);
+}
+
+TEST_CASE("[Task] runs once") {
+    Counter::alive = 0;
+    int runs = 0;
+
+    SECTION("Inline captures") {
+        sh::Task task = [&runs, counter = Counter{}, owned = std::make_unique<int>(2)]() { runs += *owned; };
+        REQUIRE(task);
+        REQUIRE(Counter::alive == 1);
+        task.run();
+        REQUIRE_FALSE(task);
+        REQUIRE(runs == 2);
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Pooled captures") {
+        std::array<int, 32> values{};
+        values[31] = 3;
+        sh::Task task = [&runs, values, counter = Counter{}]() { runs += values[31]; };
+        auto moved = std::move(task);
+        REQUIRE_FALSE(task);
+        moved.run();
+        REQUIRE(runs == 3);
+        REQUIRE(Counter::alive == 0);
+    }
+
+    SECTION("Destroyed without running") {
+        {
+            sh::Task inlineTask = [&runs, counter = Counter{}]() { runs++; };
+            std::array<int, 32> values{};
+            sh::Task pooledTask = [&runs, values, counter = Counter{}]() { runs++; };
+            REQUIRE(Counter::alive == 2);
+        }
+        REQUIRE(Counter::alive == 0);
+        REQUIRE(runs == 0);
+    }
+
+    SECTION("Throwing callables are still destroyed") {
+        sh::Task task = [counter = Counter{}]() { throw std::runtime_error("failed"); };
+        REQUIRE_THROWS_AS(task.run(), std::runtime_error);
+        REQUIRE_FALSE(task);
+        REQUIRE(Counter::alive == 0);
+
+        // Nothing is left to relocate
+        Counter::moves = 0;
+        auto moved = std::move(task);
+        REQUIRE_FALSE(moved);
+        REQUIRE(Counter::moves == 0);
+    }
+}
+
+TEST_CASE("[Task] queue across threads") {
+    std::deque<sh::Task> queue;
+    int sum = 0;
+    for (int i = 1; i <= 10; i++) {
+        std::array<int, 16> padding{};
+        padding[0] = i;
+        if (i % 2) {
+            queue.emplace_back([&sum, i]() { sum += i; });
+        } else {
+            queue.emplace_back([&sum, padding]() { sum += padding[0]; });
+        }
+    }
+    // Pooled blocks are freed on the running thread
+    std::thread([&]() {
+        while (!queue.empty()) {
+            queue.front().run();
+            queue.pop_front();
+        }
+    }).join();
+    REQUIRE(sum == 55);
+}
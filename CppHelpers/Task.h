@@ -0,0 +1,162 @@
+//
+//  Task.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MoveOnlyFunction.h"
+#include "Relocatable.h"
+
+namespace sh {
+// One-shot, move-only unit of work for executor queues, sized and aligned to exactly one cache
+// line so that every queue slot is one. Compared to std::function<void()> (32 bytes plus an
+// allocation for most real captures), captures up to InlineBytes are stored inline, larger ones
+// come from the per-thread pools (see PooledFunctionAllocator).
+// Like Guard, the callable is only remembered through a capture-less trampoline, which runs and
+// destroys it (and frees its block) in a single indirect call. Moving a task copies only the
+// callable's bytes (or the pointer to its block) unless the callable isn't trivially
+// relocatable, see RelocateTrivially.
+// Example :
+// queue.push(Task([request = std::move(request)]() { handle(request); }));
+// ...
+// queue.pop().run();
+class alignas(64) Task {
+public:
+    static constexpr std::size_t InlineBytes = 48;
+
+    // Callables which are stored inline, anything else comes from the pools
+    template <typename F>
+    static constexpr bool StoredInline = sizeof(F) <= InlineBytes && alignof(F) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<F>;
+
+    Task() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> &&
+                                                      std::is_invocable_v<std::decay_t<F>&>>>
+    Task(F&& f) {
+        using D = std::decay_t<F>;
+        if constexpr (StoredInline<D>) {
+            new (&storage_) D(std::forward<F>(f));
+            trampoline_ = [](void* storage, bool run) {
+                auto& target = *static_cast<D*>(storage);
+                // Destroys the target even if running it throws
+                Destroy<D> destroy{target};
+                if (run) {
+                    target();
+                }
+            };
+            if constexpr (IsTriviallyRelocatable_v<D>) {
+                relocate_ = &RelocateTrivially<D>;
+            } else {
+                relocate_ = [](void* from, void* to) noexcept {
+                    auto& source = *static_cast<D*>(from);
+                    new (to) D(std::move(source));
+                    source.~D();
+                };
+            }
+        } else {
+            auto ptr = PooledFunctionAllocator::allocate<D>();
+            try {
+                new (ptr) D(std::forward<F>(f));
+            } catch (...) {
+                PooledFunctionAllocator::deallocate<D>(ptr);
+                throw;
+            }
+            *reinterpret_cast<void**>(&storage_) = ptr;
+            // Moving only transfers the pointer
+            relocate_ = &RelocateTrivially<D*>;
+            trampoline_ = [](void* storage, bool run) {
+                auto target = *static_cast<D**>(storage);
+                Destroy<D> destroy{*target};
+                if (run) {
+                    (*target)();
+                }
+            };
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // Destroys the callable without running it
+    ~Task() {
+        reset();
+    }
+
+    // Runs the callable and destroys it, leaving the task empty (also if the callable throws)
+    void run() {
+        assert(trampoline_ && "Running an empty task");
+        // Emptied before running, so a throwing callable leaves nothing behind to relocate
+        relocate_ = nullptr;
+        std::exchange(trampoline_, nullptr)(&storage_, true);
+    }
+
+    void reset() noexcept {
+        if (trampoline_) {
+            std::exchange(trampoline_, nullptr)(&storage_, false);
+            relocate_ = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return trampoline_ != nullptr;
+    }
+
+private:
+    // Destroys (and for pooled targets frees) the target at the end of the trampoline
+    template <typename D>
+    struct Destroy {
+        D& target;
+
+        ~Destroy() {
+            if constexpr (StoredInline<D>) {
+                target.~D();
+            } else {
+                auto ptr = &target;
+                ptr->~D();
+                PooledFunctionAllocator::deallocate<D>(ptr);
+            }
+        }
+    };
+
+    void moveFrom(Task& other) noexcept {
+        // The storage of an empty task is uninitialized
+        if (!other.trampoline_) {
+            return;
+        }
+        other.relocate_(&other.storage_, &storage_);
+        trampoline_ = std::exchange(other.trampoline_, nullptr);
+        relocate_ = std::exchange(other.relocate_, nullptr);
+    }
+
+    // Runs the target if the flag is set, and destroys it in either case
+    void (*trampoline_)(void* storage, bool run) = nullptr;
+    // Moves the target and destroys the source, nullptr for empty tasks
+    void (*relocate_)(void* from, void* to) noexcept = nullptr;
+    std::aligned_storage_t<InlineBytes, alignof(std::max_align_t)> storage_;
+};
+
+static_assert(sizeof(Task) == 64);
+}
@@ -0,0 +1,146 @@
+//
+//  ThreadExitHooks.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ThreadExitHooks.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using sh::ThreadExitHooks;
+
+// Catch assertions aren't thread-safe, so the threads only record what they observe and the
+// checks happen on the test thread after join()
+TEST_CASE("[ThreadExitHooks] hooks run at thread exit") {
+    std::vector<int> order;
+
+    SECTION("In reverse order of registration") {
+        std::size_t size = 0;
+        bool ranEarly = true;
+        std::thread([&order, &size, &ranEarly]() {
+            ThreadExitHooks::add([&order]() noexcept { order.push_back(1); });
+            ThreadExitHooks::add([&order]() noexcept { order.push_back(2); });
+            ThreadExitHooks::add([&order]() noexcept { order.push_back(3); });
+            size = ThreadExitHooks::size();
+            ranEarly = !order.empty();
+        }).join();
+        REQUIRE(size == 3);
+        REQUIRE_FALSE(ranEarly);
+        REQUIRE(order == std::vector<int>{3, 2, 1});
+    }
+
+    SECTION("Dismissed hooks don't run") {
+        bool middleActive = true;
+        std::vector<std::size_t> sizes;
+        std::thread([&order, &middleActive, &sizes]() {
+            ThreadExitHooks::add([&order]() noexcept { order.push_back(1); });
+            auto middle = ThreadExitHooks::add([&order]() noexcept { order.push_back(2); });
+            auto last = ThreadExitHooks::add([&order]() noexcept { order.push_back(3); });
+            middle.dismiss();
+            middleActive = static_cast<bool>(middle);
+            sizes.push_back(ThreadExitHooks::size());
+            last.dismiss();
+            sizes.push_back(ThreadExitHooks::size());
+            // Dismissing twice is harmless
+            middle.dismiss();
+            sizes.push_back(ThreadExitHooks::size());
+        }).join();
+        REQUIRE_FALSE(middleActive);
+        REQUIRE(sizes == std::vector<std::size_t>{2, 1, 1});
+        REQUIRE(order == std::vector<int>{1});
+    }
+
+    SECTION("Slots of dismissed hooks are reused") {
+        std::size_t size = 1;
+        std::thread([&size]() {
+            for (std::size_t i = 0; i < 2 * ThreadExitHooks::Capacity; i++) {
+                ThreadExitHooks::add([]() noexcept {}).dismiss();
+            }
+            size = ThreadExitHooks::size();
+        }).join();
+        REQUIRE(size == 0);
+    }
+
+    SECTION("Slots of dismissed hooks in the middle are reused") {
+        std::size_t size = 0;
+        bool threw = false;
+        std::thread([&order, &size, &threw]() {
+            try {
+                ThreadExitHooks::add([&order]() noexcept { order.push_back(1); });
+                auto hole = ThreadExitHooks::add([&order]() noexcept { order.push_back(-1); });
+                auto moved = ThreadExitHooks::add([&order]() noexcept { order.push_back(-2); });
+                ThreadExitHooks::add([&order]() noexcept { order.push_back(2); });
+                hole.dismiss();
+                // Every iteration leaves a dismissed hook behind the newest one
+                auto last = ThreadExitHooks::add([]() noexcept {});
+                for (std::size_t i = 0; i < 2 * ThreadExitHooks::Capacity; i++) {
+                    auto next = ThreadExitHooks::add([]() noexcept {});
+                    last.dismiss();
+                    last = next;
+                }
+                last.dismiss();
+                // Other hooks keep their slot, so their handles stay valid
+                moved.dismiss();
+                ThreadExitHooks::add([&order]() noexcept { order.push_back(3); });
+                size = ThreadExitHooks::size();
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+        }).join();
+        REQUIRE_FALSE(threw);
+        REQUIRE(size == 3);
+        REQUIRE(order == std::vector<int>{3, 2, 1});
+    }
+
+    SECTION("Stale handles don't dismiss newer hooks") {
+        std::size_t size = 0;
+        std::thread([&order, &size]() {
+            auto stale = ThreadExitHooks::add([&order]() noexcept { order.push_back(1); });
+            auto copy = stale;
+            stale.dismiss();
+            ThreadExitHooks::add([&order]() noexcept { order.push_back(2); });
+            copy.dismiss();
+            size = ThreadExitHooks::size();
+        }).join();
+        REQUIRE(size == 1);
+        REQUIRE(order == std::vector<int>{2});
+    }
+
+    SECTION("Hooks can add hooks while the thread exits") {
+        std::thread([&order]() {
+            ThreadExitHooks::add([&order]() noexcept {
+                order.push_back(1);
+                ThreadExitHooks::add([&order]() noexcept { order.push_back(2); });
+            });
+        }).join();
+        REQUIRE(order == std::vector<int>{1, 2});
+    }
+
+    SECTION("Registering too many hooks throws") {
+        bool threw = false;
+        bool rejectedRan = false;
+        bool ranAtThrow = true;
+        std::thread([&threw, &rejectedRan, &ranAtThrow]() {
+            for (std::size_t i = 0; i < ThreadExitHooks::Capacity; i++) {
+                ThreadExitHooks::add([]() noexcept {});
+            }
+            try {
+                ThreadExitHooks::add([&rejectedRan]() noexcept { rejectedRan = true; });
+            } catch (const std::runtime_error&) {
+                threw = true;
+                ranAtThrow = rejectedRan;
+            }
+        }).join();
+        REQUIRE(threw);
+        // The rejected hook runs neither while unwinding nor at thread exit
+        REQUIRE_FALSE(ranAtThrow);
+        REQUIRE_FALSE(rejectedRan);
+    }
+}
@@ -0,0 +1,194 @@
+//
+//  ThreadExitHooks.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ArrayVector.h"
+#include "Guard.h"
+
+namespace sh {
+// Per-thread registry of cleanups that run when the calling thread exits, in reverse order of
+// registration. Every thread_local with a non-trivial destructor costs its own thread exit
+// registration and forces the compiler to go through an init check on every access. With the
+// hooks, thread-local state can stay trivially destructible and register its cleanup here :
+// struct Buffer { char* data; std::size_t size; }; // trivially destructible
+// Buffer& localBuffer() {
+//     static thread_local Buffer buffer{};
+//     if (!buffer.data) {
+//         buffer.data = new char[1024];
+//         ThreadExitHooks::add([]() noexcept { flush(localBuffer()); delete[] localBuffer().data; });
+//     }
+//     return buffer;
+// }
+// Hooks are stored inline (see InplaceGuard), so they must be noexcept and fit in HookBytes.
+// Having more than Capacity pending hooks on a thread throws, slots of dismissed hooks are
+// reused. Hooks keep their slot until they run or are dismissed, so registering and dismissing
+// are both O(1) : handles refer to slots through an index and a generation (like Connection in
+// Signal.h), and the order of registration is kept by an intrusive list through the slots.
+// Hooks may register further hooks while the thread exits, those run as well. Hooks registered
+// after the registry has been torn down (eg. from another thread_local destructor that runs
+// later) execute immediately.
+class ThreadExitHooks {
+public:
+    static constexpr std::size_t Capacity = 64;
+    static constexpr std::size_t HookBytes = 24;
+
+    // Identifies a registered hook so that it can be dismissed. Handles are only valid on the
+    // thread that registered the hook.
+    class Handle {
+    public:
+        constexpr Handle() noexcept = default;
+
+        // The hook won't run at thread exit. Dismissing a hook that already ran is a no-op.
+        void dismiss() noexcept {
+            if (generation_ != 0) {
+                ThreadExitHooks::dismiss(index_, generation_);
+                generation_ = 0;
+            }
+        }
+
+        explicit operator bool() const noexcept {
+            return generation_ != 0;
+        }
+
+    private:
+        friend class ThreadExitHooks;
+
+        constexpr Handle(std::uint32_t index, std::uint32_t generation) noexcept
+            : index_(index), generation_(generation) {}
+
+        std::uint32_t index_ = 0;
+        // 0 marks an empty handle
+        std::uint32_t generation_ = 0;
+    };
+
+    template <typename Hook, typename = std::enable_if_t<!std::is_lvalue_reference_v<Hook>>>
+    static Handle add(Hook&& hook) {
+        InplaceGuard<HookBytes> guard(std::forward<Hook>(hook));
+        if (state().exited) {
+            guard.reset();
+            return {};
+        }
+        auto& reg = registry();
+        std::uint32_t index;
+        if (reg.freeHead != None) {
+            index = reg.freeHead;
+            reg.freeHead = reg.slots[index].older;
+        } else if (reg.slots.size() < reg.slots.capacity()) {
+            index = static_cast<std::uint32_t>(reg.slots.size());
+            reg.slots.emplace_back();
+        } else {
+            // The rejected hook must not run on the way out
+            guard.dismiss();
+            throw std::runtime_error("Too many thread exit hooks");
+        }
+        auto& slot = reg.slots[index];
+        slot.guard = std::move(guard);
+        slot.older = reg.newest;
+        slot.newer = None;
+        if (reg.newest != None) {
+            reg.slots[reg.newest].newer = index;
+        }
+        reg.newest = index;
+        reg.count++;
+        return Handle(index, slot.generation);
+    }
+
+    // Number of hooks pending on the calling thread
+    static std::size_t size() noexcept {
+        return state().exited ? 0 : registry().count;
+    }
+
+private:
+    static constexpr std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+    // For pending hooks older and newer link the list in order of registration, free slots are
+    // linked through older.
+    struct Slot {
+        InplaceGuard<HookBytes> guard;
+        // Bumped whenever the slot is freed, so that stale handles don't match a newer hook.
+        // Wraps around skipping 0 : a handle kept across 2^32 - 1 reuses of the same slot could
+        // then match a newer hook, which is an accepted limitation.
+        std::uint32_t generation = 1;
+        std::uint32_t older = None;
+        std::uint32_t newer = None;
+    };
+
+    // The only thread_local with a destructor, created on the first add()
+    struct Registry {
+        ~Registry() {
+            while (newest != None) {
+                // Hooks may add more hooks, so take the guard out before running it
+                auto guard = std::move(slots[newest].guard);
+                release(newest);
+                guard.reset();
+            }
+            state().exited = true;
+        }
+
+        // Unlinks a pending hook's slot and puts it on the free list
+        void release(std::uint32_t index) noexcept {
+            auto& slot = slots[index];
+            if (slot.older != None) {
+                slots[slot.older].newer = slot.newer;
+            }
+            if (slot.newer != None) {
+                slots[slot.newer].older = slot.older;
+            } else {
+                newest = slot.older;
+            }
+            if (++slot.generation == 0) {
+                slot.generation = 1;
+            }
+            slot.older = freeHead;
+            slot.newer = None;
+            freeHead = index;
+            count--;
+        }
+
+        ArrayVector<Slot, Capacity> slots;
+        std::uint32_t newest = None;
+        std::uint32_t freeHead = None;
+        std::size_t count = 0;
+    };
+
+    // Kept trivially destructible so that it remains usable after the registry is destroyed
+    struct State {
+        bool exited;
+    };
+
+    static State& state() noexcept {
+        static thread_local State state{};
+        return state;
+    }
+
+    static Registry& registry() noexcept {
+        static thread_local Registry registry;
+        return registry;
+    }
+
+    static void dismiss(std::uint32_t index, std::uint32_t generation) noexcept {
+        if (state().exited) {
+            return;
+        }
+        auto& reg = registry();
+        if (index >= reg.slots.size() || reg.slots[index].generation != generation) {
+            return;
+        }
+        reg.slots[index].guard.dismiss();
+        reg.release(index);
+    }
+};
+}
@@ -0,0 +1,136 @@
+//
+//  ThreadRecords.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+namespace detail {
+// Domains which are currently alive. Thread exit handlers consult this so that they never
+// touch a domain which was destroyed before the thread exited.
+inline std::mutex& DomainRegistryMutex() noexcept {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::unordered_set<std::uint64_t>& LiveDomains() noexcept {
+    static std::unordered_set<std::uint64_t> domains;
+    return domains;
+}
+
+inline std::uint64_t NextDomainId() noexcept {
+    static std::atomic<std::uint64_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Fixed table of per-thread records used by the memory reclamation domains (see Epoch and
+// HazardDomain). Every thread which uses a domain claims one record the first time it calls
+// local(). The record is handed back when the thread exits and the next thread to claim it
+// inherits its contents (eg. objects still waiting to be freed).
+// Scanners only need to look at records [0, count()), which is the high-water mark of
+// claimed records rather than MaxThreads.
+template <typename Record, std::size_t MaxThreads>
+class ThreadRecords : NonCopyable, NonMovable {
+public:
+    ThreadRecords() : id_(NextDomainId()), slots_(new Slot[MaxThreads]) {
+        std::lock_guard<std::mutex> lock(DomainRegistryMutex());
+        LiveDomains().insert(id_);
+    }
+
+    ~ThreadRecords() {
+        std::lock_guard<std::mutex> lock(DomainRegistryMutex());
+        LiveDomains().erase(id_);
+    }
+
+    Record& local() {
+        static thread_local ThreadCache cache;
+        // Most threads only ever use one or two domains, so a linear scan is the fastest option
+        for (auto& entry : cache.entries) {
+            if (entry.table == this && entry.id == id_) {
+                return entry.slot->record;
+            }
+        }
+        auto& slot = claim();
+        // Drop stale entries of a destroyed table which lived at the same address
+        cache.entries.erase(std::remove_if(cache.entries.begin(), cache.entries.end(), [this](auto& entry) {
+            return entry.table == this;
+        }), cache.entries.end());
+        cache.entries.push_back({this, id_, &slot});
+        return slot.record;
+    }
+
+    std::size_t count() const noexcept {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    Record& operator[](std::size_t pos) noexcept {
+        return slots_[pos].record;
+    }
+
+    const Record& operator[](std::size_t pos) const noexcept {
+        return slots_[pos].record;
+    }
+
+private:
+    struct Slot {
+        Record record;
+        std::atomic<bool> owned{false};
+    };
+
+    struct CacheEntry {
+        const ThreadRecords* table;
+        std::uint64_t id;
+        Slot* slot;
+    };
+
+    struct ThreadCache {
+        std::vector<CacheEntry> entries;
+
+        ~ThreadCache() {
+            std::lock_guard<std::mutex> lock(DomainRegistryMutex());
+            for (auto& entry : entries) {
+                if (LiveDomains().count(entry.id)) {
+                    entry.slot->owned.store(false, std::memory_order_release);
+                }
+            }
+        }
+    };
+
+    Slot& claim() {
+        for (std::size_t i = 0; i < MaxThreads; i++) {
+            auto& slot = slots_[i];
+            bool expected = false;
+            if (!slot.owned.load(std::memory_order_relaxed) &&
+                slot.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                auto count = count_.load(std::memory_order_relaxed);
+                while (count < i + 1 &&
+                       !count_.compare_exchange_weak(count, i + 1, std::memory_order_release)) {}
+                return slot;
+            }
+        }
+        throw std::runtime_error("Too many threads using the domain");
+    }
+
+    const std::uint64_t id_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::size_t> count_{0};
+};
+}
+}
@@ -0,0 +1,44 @@
+//
+//  Transaction.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "Guard.h"
+#include "Transaction.h"
+
+#include <vector>
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+// Models a config reload which applies 30 changes and then commits.
+TEST_CASE("Committing 30 steps", "[!benchmark][Transaction]") {
+    constexpr int StepCount = 30;
+    int values[StepCount] = {};
+
+    BENCHMARK("Transaction") {
+        sh::Transaction<StepCount> txn;
+        for (int i = 0; i < StepCount; i++) {
+            const auto old = values[i]++;
+            txn.onRollback([&values, i, old]() noexcept { values[i] = old; });
+        }
+        txn.commit();
+        return values[0];
+    };
+
+    BENCHMARK("makeGuard + dismiss") {
+        std::vector<sh::GuardKey> guards;
+        for (int i = 0; i < StepCount; i++) {
+            const auto old = values[i]++;
+            guards.push_back(sh::makeGuard([&values, i, old]() noexcept { values[i] = old; }));
+        }
+        for (auto& guard : guards) {
+            guard->dismiss();
+        }
+        return values[0];
+    };
+}
@@ -0,0 +1,113 @@
+//
+//  Transaction.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "Transaction.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("[Transaction] commit and rollback") {
+    std::vector<int> applied;
+    // Undo steps are noexcept, a failing REQUIRE inside one would terminate instead of being
+    // reported, so they only count the steps undone out of order
+    int outOfOrder = 0;
+    auto apply = [&](auto& txn, int change) {
+        applied.push_back(change);
+        txn.onRollback([&applied, &outOfOrder, change]() noexcept {
+            if (applied.empty() || applied.back() != change) {
+                outOfOrder++;
+                return;
+            }
+            applied.pop_back();
+        });
+    };
+
+    SECTION("Undo runs in reverse on destruction") {
+        {
+            sh::Transaction<4> txn;
+            apply(txn, 1);
+            apply(txn, 2);
+            apply(txn, 3);
+            REQUIRE(txn.size() == 3);
+        }
+        REQUIRE(applied.empty());
+    }
+
+    SECTION("Undo runs when an exception escapes") {
+        auto reload = [&]() {
+            sh::Transaction<4> txn;
+            apply(txn, 1);
+            apply(txn, 2);
+            throw std::runtime_error("bad change");
+        };
+        REQUIRE_THROWS(reload());
+        REQUIRE(applied.empty());
+    }
+
+    SECTION("Committed changes are kept") {
+        {
+            sh::Transaction<4> txn;
+            apply(txn, 1);
+            apply(txn, 2);
+            txn.commit();
+            REQUIRE(txn.empty());
+            apply(txn, 3);
+        }
+        REQUIRE(applied == std::vector<int>{1, 2});
+    }
+
+    SECTION("Nested savepoints") {
+        sh::Transaction<8> txn;
+        apply(txn, 1);
+        auto outer = txn.savepoint();
+        apply(txn, 2);
+        auto inner = txn.savepoint();
+        apply(txn, 3);
+        apply(txn, 4);
+
+        txn.rollbackTo(inner);
+        REQUIRE(applied == std::vector<int>{1, 2});
+        apply(txn, 5);
+        txn.rollbackTo(outer);
+        REQUIRE(applied == std::vector<int>{1});
+        txn.rollback();
+        REQUIRE(applied.empty());
+    }
+
+    SECTION("Steps beyond the inline capacity spill over") {
+        sh::Transaction<2> txn;
+        for (int i = 0; i < 6; i++) {
+            apply(txn, i);
+        }
+        auto savepoint = txn.savepoint();
+        apply(txn, 6);
+        txn.rollbackTo(3);
+        REQUIRE(applied == std::vector<int>{0, 1, 2});
+        REQUIRE(savepoint == 6);
+        txn.rollbackTo(1);
+        REQUIRE(applied == std::vector<int>{0});
+        txn.rollback();
+        REQUIRE(applied.empty());
+    }
+
+    REQUIRE(outOfOrder == 0);
+}
+
+TEST_CASE("[Transaction] undo targets are released") {
+    auto owner = std::make_shared<int>(10);
+    std::weak_ptr<int> weakPtr = owner;
+    {
+        sh::Transaction<2> txn;
+        txn.onRollback([ptr = std::move(owner)]() noexcept {});
+        txn.commit();
+        REQUIRE(weakPtr.use_count() == 0);
+    }
+}
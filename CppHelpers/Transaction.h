@@ -0,0 +1,116 @@
+//
+//  Transaction.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "ArrayVector.h"
+#include "Guard.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+
+namespace sh {
+// Journal of undo actions for a sequence of changes that must either all be applied or all be
+// reverted. Every step records an undo target, which is stored in an InplaceGuard slot of an
+// inline ArrayVector, so recording doesn't allocate as long as there are at most Steps steps.
+// Example :
+// void reload(Config& config, const Changes& changes) {
+//     Transaction<32> txn;
+//     for (auto& change : changes) {
+//         auto old = config.apply(change); // may throw
+//         txn.onRollback([&config, old]() noexcept { config.restore(old); });
+//     }
+//     txn.commit();
+// }
+// If the transaction is destroyed without commit(), every recorded undo executes in reverse
+// order. Savepoints allow nested partial rollback :
+// auto savepoint = txn.savepoint();
+// ... apply optional changes, txn.rollbackTo(savepoint) if they don't work out
+// Undo targets must be noexcept and fit in StepBytes (see InplaceGuard). Steps beyond the
+// inline capacity spill over to the heap rather than fail, since failing to record an undo
+// would leave a change that can't be reverted.
+template <std::size_t Steps = 32, std::size_t StepBytes = 24>
+class Transaction : NonCopyable, NonMovable {
+public:
+    // Number of steps recorded at the time savepoint() was called
+    using Savepoint = std::size_t;
+
+    Transaction() = default;
+
+    ~Transaction() {
+        rollback();
+    }
+
+    // Records the undo action for a change that has just been applied
+    template <typename Undo, typename = std::enable_if_t<!std::is_lvalue_reference_v<Undo>>>
+    void onRollback(Undo&& undo) {
+        if (inline_.size() < inline_.capacity()) {
+            inline_.emplace_back(std::forward<Undo>(undo));
+        } else {
+            overflow_.emplace_back(std::forward<Undo>(undo));
+        }
+    }
+
+    Savepoint savepoint() const noexcept {
+        return size();
+    }
+
+    // Executes, in reverse order, the undo actions recorded after the savepoint was taken.
+    // Savepoints taken after this one are invalidated.
+    void rollbackTo(Savepoint savepoint) noexcept {
+        assert(savepoint <= size());
+        // Guards execute on destruction, so shrinking from the back runs them in reverse
+        const auto overflowSize = savepoint > Steps ? savepoint - Steps : 0;
+        while (overflow_.size() > overflowSize) {
+            overflow_.pop_back();
+        }
+        // Bounding the loop by Steps lets the compiler see that it stays within inline_ (g++
+        // reports -Warray-bounds otherwise)
+        for (auto i = std::min(inline_.size(), Steps); i > savepoint; i--) {
+            inline_.pop_back();
+        }
+    }
+
+    // Reverts everything that wasn't committed
+    void rollback() noexcept {
+        rollbackTo(0);
+    }
+
+    // Keeps every change recorded so far, the transaction can then be reused for a new
+    // sequence of changes.
+    void commit() noexcept {
+        for (auto& step : inline_) {
+            step.dismiss();
+        }
+        for (auto& step : overflow_) {
+            step.dismiss();
+        }
+        inline_.clear();
+        overflow_.clear();
+    }
+
+    std::size_t size() const noexcept {
+        return inline_.size() + overflow_.size();
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    using Step = InplaceGuard<StepBytes>;
+
+    ArrayVector<Step, Steps> inline_;
+    std::vector<Step> overflow_;
+};
+}
@@ -0,0 +1,370 @@
+//
+//  TypeErasure.Bench.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include "AllocationCounter.h"
+#include "InplaceFunction.h"
+#include "MoveOnlyFunction.h"
+#include "Poly.h"
+#include "TEContainer.h"
+#include "Task.h"
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Compares the repo's type-erased wrappers against std::function, std::any and a virtual base
+// held by unique_ptr, for payloads of 0 (captureless), 16, 48 and 256 bytes. Besides the Catch
+// timings, every operation is run a fixed number of times to report allocations per operation
+// (see AllocationCounter) and, on Linux, branch misses per operation from the hardware counters
+// ("n/a" where perf_event_open isn't permitted).
+
+namespace {
+// Counts branch misses of the calling thread, if the platform and permissions allow it
+class BranchMisses {
+public:
+    BranchMisses() noexcept {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~BranchMisses() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    bool available() const noexcept {
+        return fd_ >= 0;
+    }
+
+    void start() noexcept {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::uint64_t stop() noexcept {
+        std::uint64_t count = 0;
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// Counter results are collected and printed after each wrapper's timings, printing them as they
+// are measured would interleave them with Catch's table
+std::vector<std::string>& counterReport() {
+    static std::vector<std::string> lines;
+    return lines;
+}
+
+// Runs op a fixed number of times and records allocations and branch misses per run
+template <typename Op>
+void reportCounters(const std::string& name, Op&& op) {
+    static BranchMisses branchMisses;
+    constexpr int Runs = 1000;
+    sh::AllocationCounter allocations;
+    branchMisses.start();
+    for (int i = 0; i < Runs; i++) {
+        op();
+    }
+    auto misses = branchMisses.stop();
+    auto allocationsPerOp = static_cast<double>(allocations.count()) / Runs;
+    char line[128];
+    if (branchMisses.available()) {
+        std::snprintf(line, sizeof(line), "%-44s %6.2f allocs/op %8.3f branch-misses/op", name.c_str(),
+                      allocationsPerOp, static_cast<double>(misses) / Runs);
+    } else {
+        std::snprintf(line, sizeof(line), "%-44s %6.2f allocs/op      n/a branch-misses/op", name.c_str(),
+                      allocationsPerOp);
+    }
+    counterReport().push_back(line);
+}
+
+template <std::size_t Bytes>
+struct Payload {
+    std::array<unsigned char, Bytes> bytes{};
+    int operator()() const noexcept { return bytes[0] + static_cast<int>(Bytes); }
+};
+
+template <>
+struct Payload<0> {
+    int operator()() const noexcept { return 0; }
+};
+
+struct CallableBase {
+    virtual ~CallableBase() = default;
+    virtual int operator()() const = 0;
+    virtual std::unique_ptr<CallableBase> clone() const = 0;
+};
+
+template <typename P>
+struct Callable final : CallableBase {
+    explicit Callable(const P& p) : payload(p) {}
+    int operator()() const override { return payload(); }
+    std::unique_ptr<CallableBase> clone() const override { return std::make_unique<Callable>(payload); }
+    P payload;
+};
+
+struct CallableInterface : sh::PolyInterface<int() const> {
+    template <typename T>
+    static constexpr auto Impl = std::make_tuple([](const T& t) { return t(); });
+
+    template <typename Self>
+    struct Api {
+        int operator()() const { return static_cast<const Self&>(*this).template invoke<0>(); }
+    };
+};
+
+int taskResult = 0;
+
+// Adapters giving every wrapper the same interface : make, copy (if Copyable) and invoke (if
+// Invocable). Task is one-shot, it is invoked by constructing and running it (see run).
+template <typename P>
+struct StdFunction {
+    static constexpr auto Name = "std::function";
+    static constexpr bool Copyable = true;
+    static constexpr bool Invocable = true;
+    using Type = std::function<int()>;
+    static Type make(const P& p) { return p; }
+    static Type copy(const Type& t) { return t; }
+    static int invoke(const Type& t) { return t(); }
+};
+
+template <typename P>
+struct StdAny {
+    static constexpr auto Name = "std::any";
+    static constexpr bool Copyable = true;
+    static constexpr bool Invocable = true;
+    using Type = std::any;
+    static Type make(const P& p) { return p; }
+    static Type copy(const Type& t) { return t; }
+    static int invoke(const Type& t) { return std::any_cast<const P&>(t)(); }
+};
+
+template <typename P>
+struct VirtualBase {
+    static constexpr auto Name = "unique_ptr<Base>";
+    static constexpr bool Copyable = true;
+    static constexpr bool Invocable = true;
+    using Type = std::unique_ptr<CallableBase>;
+    static Type make(const P& p) { return std::make_unique<Callable<P>>(p); }
+    static Type copy(const Type& t) { return t->clone(); }
+    static int invoke(const Type& t) { return (*t)(); }
+};
+
+template <typename P>
+struct TEContainerAdapter {
+    static constexpr auto Name = "sh::TEContainer";
+    static constexpr bool Copyable = true;
+    static constexpr bool Invocable = true;
+    using Type = sh::TEContainer<>;
+    static Type make(const P& p) { return p; }
+    static Type copy(const Type& t) { return t; }
+    static int invoke(const Type& t) { return sh::any_cast<const P&>(t)(); }
+};
+
+template <typename P>
+struct InplaceFunctionAdapter {
+    static constexpr auto Name = "sh::InplaceFunction<256>";
+    static constexpr bool Copyable = true;
+    static constexpr bool Invocable = true;
+    using Type = sh::InplaceFunction<int(), 256>;
+    static Type make(const P& p) { return p; }
+    static Type copy(const Type& t) { return t; }
+    static int invoke(const Type& t) { return t(); }
+};
+
+template <typename P>
+struct MoveOnlyFunctionAdapter {
+    static constexpr auto Name = "sh::MoveOnlyFunction";
+    static constexpr bool Copyable = false;
+    static constexpr bool Invocable = true;
+    using Type = sh::MoveOnlyFunction<int() const>;
+    static Type make(const P& p) { return p; }
+    static int invoke(const Type& t) { return t(); }
+};
+
+template <typename P>
+struct PolyAdapter {
+    static constexpr auto Name = "sh::Poly<256>";
+    static constexpr bool Copyable = false;
+    static constexpr bool Invocable = true;
+    using Type = sh::Poly<CallableInterface, 256>;
+    static Type make(const P& p) { return p; }
+    static int invoke(const Type& t) { return t(); }
+};
+
+template <typename P>
+struct TaskAdapter {
+    static constexpr auto Name = "sh::Task";
+    static constexpr bool Copyable = false;
+    static constexpr bool Invocable = false;
+    using Type = sh::Task;
+    static Type make(const P& p) { return [p]() { taskResult = p(); }; }
+    static int run(Type& t) {
+        t.run();
+        return taskResult;
+    }
+};
+
+template <template <typename> class Adapter, std::size_t Bytes>
+void benchmarkPayload() {
+    using A = Adapter<Payload<Bytes>>;
+    using Type = typename A::Type;
+    const Payload<Bytes> payload{};
+    const auto prefix = std::string(A::Name) + " " + std::to_string(Bytes) + "B ";
+
+    BENCHMARK_ADVANCED(prefix + "construct")(Catch::Benchmark::Chronometer meter) {
+        std::vector<Catch::Benchmark::destructable_object<Type>> storage(meter.runs());
+        meter.measure([&](int i) { storage[i].construct(A::make(payload)); });
+        // Destroyed outside of the measurement, but before the next benchmark runs
+        for (auto& object : storage) {
+            object.destruct();
+        }
+    };
+    reportCounters(prefix + "construct + destroy", [&]() {
+        auto value = A::make(payload);
+        Catch::Benchmark::keep_memory(&value);
+    });
+
+    BENCHMARK_ADVANCED(prefix + "destroy")(Catch::Benchmark::Chronometer meter) {
+        std::vector<Catch::Benchmark::destructable_object<Type>> storage(meter.runs());
+        for (auto& object : storage) {
+            object.construct(A::make(payload));
+        }
+        meter.measure([&](int i) { storage[i].destruct(); });
+    };
+
+    if constexpr (A::Copyable) {
+        const auto source = A::make(payload);
+        BENCHMARK(prefix + "copy") {
+            auto copy = A::copy(source);
+            Catch::Benchmark::keep_memory(&copy);
+        };
+        reportCounters(prefix + "copy", [&]() {
+            auto copy = A::copy(source);
+            Catch::Benchmark::keep_memory(&copy);
+        });
+    }
+
+    // Moves there and back, so every iteration starts from the same state
+    auto first = A::make(payload);
+    Type second;
+    auto moveBothWays = [&]() {
+        second = std::move(first);
+        first = std::move(second);
+    };
+    BENCHMARK(prefix + "move") {
+        moveBothWays();
+    };
+    reportCounters(prefix + "move", moveBothWays);
+
+    if constexpr (A::Invocable) {
+        BENCHMARK(prefix + "invoke") {
+            return A::invoke(first);
+        };
+        reportCounters(prefix + "invoke", [&]() {
+            auto result = A::invoke(first);
+            Catch::Benchmark::keep_memory(&result);
+        });
+    } else if constexpr (std::is_same_v<Type, sh::Task>) {
+        BENCHMARK(prefix + "construct + run") {
+            auto task = A::make(payload);
+            return A::run(task);
+        };
+        reportCounters(prefix + "construct + run", [&]() {
+            auto task = A::make(payload);
+            auto result = A::run(task);
+            Catch::Benchmark::keep_memory(&result);
+        });
+    }
+}
+
+template <template <typename> class Adapter>
+void benchmarkAdapter() {
+    benchmarkPayload<Adapter, 0>();
+    benchmarkPayload<Adapter, 16>();
+    benchmarkPayload<Adapter, 48>();
+    benchmarkPayload<Adapter, 256>();
+
+    std::printf("\n");
+    for (const auto& line : counterReport()) {
+        std::printf("%s\n", line.c_str());
+    }
+    std::printf("\n");
+    counterReport().clear();
+}
+}
+
+// Run with `CppHelpers [!benchmark]`, these are hidden from the default test run.
+// A single wrapper can be selected with its section, eg. `CppHelpers [TypeErasure] -c sh::Task`
+TEST_CASE("Type-erasure primitives", "[!benchmark][TypeErasure]") {
+    SECTION("std::function") {
+        benchmarkAdapter<StdFunction>();
+    }
+    SECTION("std::any") {
+        benchmarkAdapter<StdAny>();
+    }
+    SECTION("unique_ptr<Base>") {
+        benchmarkAdapter<VirtualBase>();
+    }
+    SECTION("sh::TEContainer") {
+        benchmarkAdapter<TEContainerAdapter>();
+    }
+    SECTION("sh::InplaceFunction") {
+        benchmarkAdapter<InplaceFunctionAdapter>();
+    }
+    SECTION("sh::MoveOnlyFunction") {
+        benchmarkAdapter<MoveOnlyFunctionAdapter>();
+    }
+    SECTION("sh::Poly") {
+        benchmarkAdapter<PolyAdapter>();
+    }
+    SECTION("sh::Task") {
+        benchmarkAdapter<TaskAdapter>();
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  TypeName.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "TypeName.h"
+
+#include <map>
+#include <vector>
+
+namespace sh::test {
+struct Widget {};
+}
+
+TEST_CASE("[TypeName] names") {
+    static_assert(sh::type_name<int>() == "int");
+    static_assert(sh::type_name<const int&>() == "const int&");
+    static_assert(sh::type_name<unsigned long>() == "long unsigned int" ||
+                  sh::type_name<unsigned long>() == "unsigned long");
+    static_assert(sh::type_name<sh::test::Widget>() == "sh::test::Widget");
+    REQUIRE(sh::type_name<std::vector<sh::test::Widget>*>().find("std::vector<sh::test::Widget") == 0);
+}
+
+TEST_CASE("[TypeName] ids") {
+    static_assert(sh::type_id<int> != sh::type_id<long>);
+    static_assert(sh::type_id<int> != sh::type_id<const int>);
+    static_assert(sh::type_id<sh::test::Widget> == sh::detail::hashTypeName("sh::test::Widget"));
+
+    SECTION("Normalization") {
+        static_assert(sh::detail::hashTypeName("struct sh::test::Widget") ==
+                      sh::type_id<sh::test::Widget>);
+        static_assert(sh::detail::hashTypeName("std::map<int, int>") ==
+                      sh::detail::hashTypeName("std::map<int,int>"));
+        static_assert(sh::detail::hashTypeName("std::vector<std::vector<int> >") ==
+                      sh::detail::hashTypeName("std::vector<std::vector<int>>"));
+        static_assert(sh::detail::hashTypeName("unsigned int") != sh::detail::hashTypeName("unsignedint"));
+        static_assert(sh::detail::hashTypeName("subclass") != sh::detail::hashTypeName("sub"));
+    }
+
+    // FNV-1a reference values, the ids are part of serialized data so they must not change
+    static_assert(sh::detail::hashTypeName("") == 0xcbf29ce484222325ull);
+    static_assert(sh::detail::hashTypeName("a") == 0xaf63dc4c8601ec8cull);
+    static_assert(sh::type_id<int> == sh::detail::hashTypeName("int"));
+}
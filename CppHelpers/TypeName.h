@@ -0,0 +1,97 @@
+//
+//  TypeName.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Lives in the global namespace since GCC spells types relative to the enclosing namespace,
+// it would print "test::Widget" for sh::test::Widget from inside sh.
+template <typename T>
+constexpr auto sh_type_name() {
+    std::string_view name;
+#if defined(__clang__) || defined(__GNUC__)
+    // "auto sh_type_name() [T = int]" or "constexpr auto sh_type_name() [with T = int]"
+    name = __PRETTY_FUNCTION__;
+    name.remove_prefix(name.find("T = ") + 4);
+    name.remove_suffix(1);
+#elif defined(_MSC_VER)
+    // "auto __cdecl sh_type_name<int>(void)"
+    name = __FUNCSIG__;
+    name.remove_prefix(name.find("sh_type_name<") + 13);
+    name.remove_suffix(7);
+#endif
+    return name;
+}
+
+namespace sh {
+// The name of T as spelled by the compiler, eg. "int" or "std::vector<int>", computed at compile
+// time from the function signature so it works without RTTI (-fno-rtti).
+// The spelling is compiler specific (eg. MSVC prefixes class types with "class "), see type_id
+// for a hash which ignores the differences that don't matter.
+template <typename T>
+constexpr std::string_view type_name() {
+    return sh_type_name<T>();
+}
+
+namespace detail {
+constexpr bool isIdentifierChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Elaborated type specifiers which MSVC adds, and the other compilers don't
+constexpr std::size_t keywordLength(std::string_view name, std::size_t pos) {
+    for (std::string_view keyword : {"struct ", "class ", "enum ", "union "}) {
+        if (name.substr(pos, keyword.size()) == keyword) {
+            return keyword.size();
+        }
+    }
+    return 0;
+}
+
+// 64 bit FNV-1a of the name with elaborated type specifiers dropped, and whitespace dropped
+// unless it separates two identifiers (eg. "unsigned int"), so that "std::map<int, int>" and
+// "std::map<int,int>" hash the same.
+constexpr std::uint64_t hashTypeName(std::string_view name) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    auto add = [&hash](char c) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    };
+    char last = '\0';
+    for (std::size_t i = 0; i < name.size(); i++) {
+        if (!isIdentifierChar(last)) {
+            if (auto skip = keywordLength(name, i)) {
+                i += skip - 1;
+                continue;
+            }
+        }
+        auto c = name[i];
+        if (c == ' ') {
+            if (isIdentifierChar(last) && i + 1 < name.size() && isIdentifierChar(name[i + 1])) {
+                add(c);
+                last = c;
+            }
+            continue;
+        }
+        add(c);
+        last = c;
+    }
+    return hash;
+}
+}
+
+// Integer identity of T which doesn't need RTTI, for type tags in registries, serialization and
+// checked casts. Unlike the address of a per-type static, it is stable across builds and
+// processes, and across compilers as long as they spell the (normalized) name the same way.
+// Types in anonymous namespaces are spelled differently by every compiler, so their ids are
+// only meaningful within a build.
+template <typename T>
+inline constexpr std::uint64_t type_id = detail::hashTypeName(type_name<T>());
+}
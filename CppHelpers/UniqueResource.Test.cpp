@@ -0,0 +1,136 @@
+//
+//  UniqueResource.Test.cpp
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#include <catch2/catch.hpp>
+
+#include "ArrayVector.h"
+#include "UniqueResource.h"
+
+#include <fcntl.h>
+
+namespace {
+bool isOpen(int fd) {
+    return ::fcntl(fd, F_GETFD) != -1;
+}
+
+struct CountingDeleter {
+    static inline int deleted = 0;
+    void operator()(int) const noexcept {
+        deleted++;
+    }
+};
+
+using Counted = sh::UniqueResource<int, CountingDeleter, -1>;
+}
+
+TEST_CASE("[UniqueResource] static asserts") {
+    static_assert(sizeof(sh::UniqueFd) == sizeof(int));
+    static_assert(sizeof(sh::UniqueFile) == sizeof(std::FILE*));
+    static_assert(sizeof(sh::UniqueMmap) == sizeof(void*) + sizeof(std::size_t));
+    static_assert(!std::is_copy_constructible_v<sh::UniqueFd>);
+    static_assert(std::is_nothrow_move_constructible_v<sh::UniqueFd>);
+    static_assert(sh::IsTriviallyRelocatable_v<sh::UniqueFd>);
+    static_assert(sh::IsTriviallyRelocatable_v<sh::UniqueMmap>);
+    static_assert(sizeof(sh::ArrayVector<sh::UniqueFd, 8>) == 8 * sizeof(int) + sizeof(std::size_t));
+}
+
+TEST_CASE("[UniqueResource] ownership") {
+    CountingDeleter::deleted = 0;
+
+    SECTION("Deleter runs on scope exit, but not for invalid handles") {
+        {
+            Counted empty;
+            REQUIRE_FALSE(empty);
+            Counted owned(3);
+            REQUIRE(owned);
+            REQUIRE(owned.get() == 3);
+        }
+        REQUIRE(CountingDeleter::deleted == 1);
+    }
+
+    SECTION("Release gives up ownership") {
+        {
+            Counted owned(3);
+            REQUIRE(owned.release() == 3);
+            REQUIRE_FALSE(owned);
+        }
+        REQUIRE(CountingDeleter::deleted == 0);
+    }
+
+    SECTION("Reset deletes the old handle") {
+        Counted owned(3);
+        owned.reset(4);
+        REQUIRE(CountingDeleter::deleted == 1);
+        REQUIRE(owned.get() == 4);
+        owned.reset();
+        REQUIRE(CountingDeleter::deleted == 2);
+        REQUIRE_FALSE(owned);
+    }
+
+    SECTION("Moving transfers ownership") {
+        Counted first(3);
+        Counted second(std::move(first));
+        REQUIRE_FALSE(first);
+        REQUIRE(second.get() == 3);
+
+        Counted third(5);
+        third = std::move(second);
+        REQUIRE(CountingDeleter::deleted == 1);
+        REQUIRE(third.get() == 3);
+    }
+}
+
+TEST_CASE("[UniqueResource] POSIX handles") {
+    SECTION("File descriptors are closed") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        {
+            sh::UniqueFd read(fds[0]);
+            sh::UniqueFd write(fds[1]);
+            REQUIRE(isOpen(fds[0]));
+        }
+        REQUIRE_FALSE(isOpen(fds[0]));
+        REQUIRE_FALSE(isOpen(fds[1]));
+    }
+
+    SECTION("Containers of descriptors are relocated") {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        sh::ArrayVector<sh::UniqueFd, 4> from;
+        from.emplace_back(fds[0]);
+        from.emplace_back(fds[1]);
+
+        auto to = std::move(from);
+        REQUIRE(from.empty());
+        REQUIRE(to.size() == 2);
+        REQUIRE(isOpen(fds[0]));
+        REQUIRE(isOpen(fds[1]));
+        to.clear();
+        REQUIRE_FALSE(isOpen(fds[0]));
+    }
+
+    SECTION("FILE handles are closed") {
+        sh::UniqueFile file(std::tmpfile());
+        REQUIRE(file);
+        REQUIRE(std::fputs("data", file.get()) >= 0);
+        file.reset();
+        REQUIRE_FALSE(file);
+    }
+
+    SECTION("Mappings are unmapped") {
+        const auto length = static_cast<std::size_t>(::getpagesize());
+        auto mapping = sh::mapMemory(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        REQUIRE(mapping);
+        REQUIRE(mapping.deleter().length == length);
+        static_cast<char*>(mapping.get())[0] = 1;
+        mapping.reset();
+
+        auto failed = sh::mapMemory(nullptr, 0, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        REQUIRE_FALSE(failed);
+    }
+}
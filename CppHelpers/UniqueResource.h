@@ -0,0 +1,142 @@
+//
+//  UniqueResource.h
+//  CppHelpers
+//
+//  Created by Sumant Hanumante on 10/17/26.
+//  Copyright © 2026 Sumant Hanumante. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "NonCopyable.h"
+#include "Relocatable.h"
+
+namespace sh {
+// Owns a raw handle (file descriptor, FILE*, mapping etc.) and releases it through Deleter
+// when going out of scope, the same way StackGuard runs its target. InvalidValue marks the
+// empty state, for which the deleter is never called.
+// Stateless deleters are stored through the empty base optimization, so the wrapper is exactly
+// sizeof(Handle) in that case. Stateful deleters (see UniqueMmap) are stored alongside.
+// Example :
+// UniqueFd fd(::open(path, O_RDONLY));
+// if (!fd) {
+//     return;
+// }
+// ::read(fd.get(), buffer, size);
+// The wrapper is trivially relocatable (see Relocatable.h) whenever Handle and Deleter are
+// trivially copyable, so containers like ArrayVector<UniqueFd, N> move it with memcpy.
+template <typename Handle, typename Deleter, Handle InvalidValue = Handle{}>
+class UniqueResource : private Deleter, NonCopyable {
+public:
+    static_assert(std::is_nothrow_invocable_v<Deleter&, Handle>, "Deleter must be noexcept");
+
+    constexpr UniqueResource() noexcept = default;
+
+    constexpr explicit UniqueResource(Handle handle) noexcept : handle_(handle) {}
+
+    constexpr UniqueResource(Handle handle, Deleter deleter) noexcept
+        : Deleter(std::move(deleter)), handle_(handle) {}
+
+    constexpr UniqueResource(UniqueResource&& other) noexcept
+        : Deleter(std::move(other.deleter())), handle_(other.release()) {}
+
+    // The currently owned handle (if any) is released before taking over other's
+    UniqueResource& operator=(UniqueResource&& other) noexcept {
+        if (this != &other) {
+            reset(other.release());
+            deleter() = std::move(other.deleter());
+        }
+        return *this;
+    }
+
+    ~UniqueResource() {
+        reset();
+    }
+
+    constexpr Handle get() const noexcept {
+        return handle_;
+    }
+
+    // Gives up ownership without calling the deleter
+    constexpr Handle release() noexcept {
+        return std::exchange(handle_, InvalidValue);
+    }
+
+    // Calls the deleter on the owned handle (if any) and takes ownership of handle
+    void reset(Handle handle = InvalidValue) noexcept {
+        auto old = std::exchange(handle_, handle);
+        if (old != InvalidValue) {
+            deleter()(old);
+        }
+    }
+
+    void reset(Handle handle, Deleter newDeleter) noexcept {
+        reset(handle);
+        deleter() = std::move(newDeleter);
+    }
+
+    constexpr Deleter& deleter() noexcept {
+        return *this;
+    }
+
+    constexpr const Deleter& deleter() const noexcept {
+        return *this;
+    }
+
+    constexpr explicit operator bool() const noexcept {
+        return handle_ != InvalidValue;
+    }
+
+private:
+    Handle handle_ = InvalidValue;
+};
+
+template <typename Handle, typename Deleter, Handle InvalidValue>
+struct IsTriviallyRelocatable<UniqueResource<Handle, Deleter, InvalidValue>>
+    : std::bool_constant<std::is_trivially_copyable_v<Handle> && std::is_trivially_copyable_v<Deleter>> {};
+
+struct FdDeleter {
+    void operator()(int fd) const noexcept {
+        ::close(fd);
+    }
+};
+
+struct FileDeleter {
+    void operator()(std::FILE* file) const noexcept {
+        std::fclose(file);
+    }
+};
+
+// munmap needs the length of the mapping, so unlike the other deleters this one has state
+struct MmapDeleter {
+    void operator()(void* address) const noexcept {
+        ::munmap(address, length);
+    }
+
+    std::size_t length = 0;
+};
+
+using UniqueFd = UniqueResource<int, FdDeleter, -1>;
+using UniqueFile = UniqueResource<std::FILE*, FileDeleter, nullptr>;
+// Empty mappings are nullptr rather than MAP_FAILED, since the latter can't be a template
+// argument. Use mapMemory to create one.
+using UniqueMmap = UniqueResource<void*, MmapDeleter, nullptr>;
+
+// Same arguments as mmap, returns an empty mapping on failure (check errno)
+inline UniqueMmap mapMemory(void* address, std::size_t length, int protection, int flags, int fd,
+                            off_t offset) noexcept {
+    auto mapped = ::mmap(address, length, protection, flags, fd, offset);
+    if (mapped == MAP_FAILED) {
+        return UniqueMmap();
+    }
+    return UniqueMmap(mapped, MmapDeleter{length});
+}
+}
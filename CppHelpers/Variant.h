@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
+#include "FunctionRef.h"
+
 namespace sh {
 
 template<size_t Index, typename Variant>
@@ -346,6 +349,46 @@ auto visit(Visitor&& visitor, Variant&& v) noexcept(detail::IsNoExcept<Visitor,
     return VisitHelper<Visitor, Variant, detail::IsNoExcept<Visitor, Variant>(), UseLookupVisitor>::run(std::forward<Visitor>(visitor), std::forward<Variant>(v));
 }
 
+namespace detail {
+template <typename T>
+struct NonDeduced {
+    using type = T;
+};
+
+template <typename T>
+using NonDeduced_t = typename NonDeduced<T>::type;
+
+// Same lookup table as VisitHelper, but there is one table per variant type and return type
+// instead of one per visitor.
+template <typename R, typename Variant, typename Handlers, std::size_t... Idx>
+R visitRef(Variant& v, const Handlers& handlers, std::index_sequence<Idx ...>) {
+    using VisitFn = R (*)(Variant&, const Handlers&);
+    static constexpr VisitFn lookup[sizeof...(Idx)] = {
+        [](Variant& v, const Handlers& handlers) -> R {
+            return std::get<Idx>(handlers)(v.template getAt<Idx>());
+        }...,
+    };
+    return lookup[v.getIndex()](v, handlers);
+}
+} // namespace detail
+
+// Type-erased visit, with one FunctionRef per alternative (in order). Unlike visit(), which is
+// instantiated for every visitor, this is compiled once per variant type, so it can back a
+// non-template function and callers only pay for the indirect calls :
+// void print(const Variant<int, std::string>& v) {
+//     visitRef(v, [](const int& i) { ... }, [](const std::string& s) { ... });
+// }
+// The return type is void by default, and is given explicitly otherwise : visitRef<int>(v, ...)
+template <typename R = void, typename... Ts>
+R visitRef(const Variant<Ts...>& v, detail::NonDeduced_t<FunctionRef<R(const Ts&)>>... handlers) {
+    return detail::visitRef<R>(v, std::make_tuple(handlers...), std::index_sequence_for<Ts...>{});
+}
+
+template <typename R = void, typename... Ts>
+R visitRef(Variant<Ts...>& v, detail::NonDeduced_t<FunctionRef<R(Ts&)>>... handlers) {
+    return detail::visitRef<R>(v, std::make_tuple(handlers...), std::index_sequence_for<Ts...>{});
+}
+
 template <typename... Ts>
 struct Overloaded : Ts... { using Ts::operator()...; };
 
@@ -11,34 +11,13 @@
 
 #include "ArrayVector.h"
 #include "Guard.h"
+#include "TypeName.h"
 #include "Variant.h"
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
-
-template <typename T>
-constexpr auto type_name()
-{
-    std::string_view name, prefix, suffix;
-#ifdef __clang__
-    name = __PRETTY_FUNCTION__;
-    prefix = "auto type_name() [T = ";
-    suffix = "]";
-#elif defined(__GNUC__)
-    name = __PRETTY_FUNCTION__;
-    prefix = "constexpr auto type_name() [with T = ";
-    suffix = "]";
-#elif defined(_MSC_VER)
-    name = __FUNCSIG__;
-    prefix = "auto __cdecl type_name<";
-    suffix = ">(void)";
-#endif
-    name.remove_prefix(prefix.size());
-    name.remove_suffix(suffix.size());
-    return name;
-}
-
 #if 0
 
 Learnings about SFINAE:
@@ -177,22 +156,22 @@ TEST_CASE( "Prototyping", "quick prototyping" ) {
         sh::Variant<int, bool, double, Test> v1(std::move(t));
         sh::visit([](const auto& v) {
             auto& t = reinterpret_cast<const Test&>(v);
-            std::cout << "[Type] " << type_name<decltype(t)>() << " "
+            std::cout << "[Type] " << sh::type_name<decltype(t)>() << " "
                 << t.ptr.use_count() << " " << sizeof(Test) << std::endl;
         }, v1);
         
         auto v2 = v1;
-        sh::visit([](auto&& v) { std::cout << "[Type] " << type_name<decltype(v)>() << std::endl; }, v2);
+        sh::visit([](auto&& v) { std::cout << "[Type] " << sh::type_name<decltype(v)>() << std::endl; }, v2);
         auto v3 = std::move(v2);
-        sh::visit([](auto&& v) { std::cout << "[Type] " << type_name<decltype(v)>() << std::endl; }, v3);
+        sh::visit([](auto&& v) { std::cout << "[Type] " << sh::type_name<decltype(v)>() << std::endl; }, v3);
         v3 = v1;
         sh::visit([](auto&& v) {
-            std::cout << "[Type] " << type_name<decltype(v)>() << std::endl;
+            std::cout << "[Type] " << sh::type_name<decltype(v)>() << std::endl;
         }, v3);
         
-        sh::visit([](auto&& v) { std::cout << "[Type] " << type_name<decltype(v)>() << std::endl; }, v1);
+        sh::visit([](auto&& v) { std::cout << "[Type] " << sh::type_name<decltype(v)>() << std::endl; }, v1);
         v1 = false;
-        sh::visit([](auto&& v) { std::cout << "[Type] " << type_name<decltype(v)>() << std::endl; }, v1);
+        sh::visit([](auto&& v) { std::cout << "[Type] " << sh::type_name<decltype(v)>() << std::endl; }, v1);
         
         sh::visit(sh::Overloaded {
             [](auto arg) { std::cout << arg << ' '; },